@@ -6,14 +6,23 @@
 
 #if defined(ENABLE_CMD)
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
 #include "debug_api.h"
+#include "format.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
+/* FNV-1a picks the bucket, the slot is a second mix of the same hash with the displacement of the bucket */
+#define CMD_API_HASH_BASIS 2166136261U
+#define CMD_API_HASH_PRIME 16777619U
+#define CMD_API_DISPLACEMENT_STEP 0x9E3779B9U
+#define CMD_API_DISPLACEMENT_ATTEMPTS (UINT8_MAX + 1U)
+
+/* A command token runs up to and including the first ':', commands without arguments are the whole message */
+#define CMD_API_TOKEN_END ':'
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
@@ -39,17 +48,200 @@ CREATE_MODULE_NAME_EMPTY
 /**********************************************************************************************************************
  * Prototypes of private functions
  *********************************************************************************************************************/
- 
+
+static uint32_t CMD_API_HashToken (const char *data, const size_t size, size_t *token_length);
+static size_t CMD_API_GetSlot (const uint32_t hash, const uint8_t displacement);
+static bool CMD_API_TryBucket (sCmdIndex_t *index, const size_t bucket, const uint8_t displacement);
+static bool CMD_API_TryIndex (sCmdIndex_t *index);
+static size_t CMD_API_ScanCommand (const char *data, const size_t token_length, const sCmdIndex_t *index);
+
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
- 
+
+/* Hashes and delimits the token in the same pass, so a lookup reads every command byte once */
+static uint32_t CMD_API_HashToken (const char *data, const size_t size, size_t *token_length) {
+    uint32_t hash = CMD_API_HASH_BASIS;
+    size_t length = 0;
+
+    while (length < size) {
+        char character = data[length];
+
+        hash ^= (uint8_t) character;
+        hash *= CMD_API_HASH_PRIME;
+        length++;
+
+        if (CMD_API_TOKEN_END == character) {
+            break;
+        }
+    }
+
+    *token_length = length;
+
+    return hash ^ (hash >> 16);
+}
+
+/* Murmur3 finalizer, every displacement gives an unrelated slot for the same hash */
+static size_t CMD_API_GetSlot (const uint32_t hash, const uint8_t displacement) {
+    uint32_t mix = hash ^ (displacement * CMD_API_DISPLACEMENT_STEP);
+
+    mix ^= mix >> 16;
+    mix *= 0x85EBCA6BU;
+    mix ^= mix >> 13;
+    mix *= 0xC2B2AE35U;
+    mix ^= mix >> 16;
+
+    return mix % CMD_API_INDEX_SLOTS;
+}
+
+/* Places every command of the bucket or none of them, two commands of one bucket may also collide with each other */
+static bool CMD_API_TryBucket (sCmdIndex_t *index, const size_t bucket, const uint8_t displacement) {
+    for (size_t command_number = 1; command_number < index->command_lut_size; command_number++) {
+        size_t token_length = 0;
+        uint32_t hash = CMD_API_HashToken(index->command_lut[command_number].command, index->command_lut[command_number].command_length, &token_length);
+
+        if (bucket != (hash % CMD_API_INDEX_BUCKETS)) {
+            continue;
+        }
+
+        size_t slot = CMD_API_GetSlot(hash, displacement);
+
+        if (0 == index->slot[slot]) {
+            index->slot[slot] = (uint8_t) command_number;
+
+            continue;
+        }
+
+        /* Commands of this bucket placed so far are the ones before this command, they are taken out again */
+        for (size_t placed_slot = 0; placed_slot < CMD_API_INDEX_SLOTS; placed_slot++) {
+            if ((0 == index->slot[placed_slot]) || (index->slot[placed_slot] >= command_number)) {
+                continue;
+            }
+
+            const sCmdDesc_t *placed = &index->command_lut[index->slot[placed_slot]];
+
+            if (bucket == (CMD_API_HashToken(placed->command, placed->command_length, &token_length) % CMD_API_INDEX_BUCKETS)) {
+                index->slot[placed_slot] = 0;
+            }
+        }
+
+        return false;
+    }
+
+    index->displacement[bucket] = displacement;
+
+    return true;
+}
+
+/* Buckets are placed largest first, while most slots are still free, the usual order for hash and displace */
+static bool CMD_API_TryIndex (sCmdIndex_t *index) {
+    uint8_t bucket_size[CMD_API_INDEX_BUCKETS] = {0};
+    size_t largest_size = 0;
+
+    memset(index->slot, 0, sizeof(index->slot));
+    memset(index->displacement, 0, sizeof(index->displacement));
+
+    for (size_t command_number = 1; command_number < index->command_lut_size; command_number++) {
+        size_t token_length = 0;
+        size_t bucket = CMD_API_HashToken(index->command_lut[command_number].command, index->command_lut[command_number].command_length, &token_length) % CMD_API_INDEX_BUCKETS;
+
+        bucket_size[bucket]++;
+
+        if (bucket_size[bucket] > largest_size) {
+            largest_size = bucket_size[bucket];
+        }
+    }
+
+    for (size_t size = largest_size; size > 0; size--) {
+        for (size_t bucket = 0; bucket < CMD_API_INDEX_BUCKETS; bucket++) {
+            if (size != bucket_size[bucket]) {
+                continue;
+            }
+
+            bool is_placed = false;
+
+            for (size_t displacement = 0; (displacement < CMD_API_DISPLACEMENT_ATTEMPTS) && !is_placed; displacement++) {
+                is_placed = CMD_API_TryBucket(index, bucket, (uint8_t) displacement);
+            }
+
+            if (!is_placed) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* Fallback for tables the index could not place, same exact token match as the hashed lookup */
+static size_t CMD_API_ScanCommand (const char *data, const size_t token_length, const sCmdIndex_t *index) {
+    for (size_t command_number = 1; command_number < index->command_lut_size; command_number++) {
+        if (token_length != index->command_lut[command_number].command_length) {
+            continue;
+        }
+
+        if (0 == memcmp(data, index->command_lut[command_number].command, token_length)) {
+            return command_number;
+        }
+    }
+
+    return 0;
+}
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
 
-eErrorCode_t CMD_API_FindCommand (sMessage_t command, sMessage_t *response, sCmdDesc_t *command_lut, const size_t command_lut_size) {
-    if ((NULL == response) || (NULL == command_lut)) {
+/* Entry 0 of every LUT is the unused _First slot, so index 0 doubles as the empty marker */
+bool CMD_API_BuildIndex (sCmdIndex_t *index, sCmdDesc_t *command_lut, const size_t command_lut_size) {
+    if ((NULL == index) || (NULL == command_lut)) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return false;
+    }
+
+    for (size_t command_number = 1; command_number < command_lut_size; command_number++) {
+        if ((NULL == command_lut[command_number].command) || (NULL == command_lut[command_number].handler)) {
+            TRACE_ERR("Command [%u] not defined\n", (unsigned int) command_number);
+
+            return false;
+        }
+
+        size_t token_length = 0;
+
+        CMD_API_HashToken(command_lut[command_number].command, command_lut[command_number].command_length, &token_length);
+
+        if (token_length != command_lut[command_number].command_length) {
+            TRACE_ERR("Command [%s] continues past its token\n", command_lut[command_number].command);
+
+            return false;
+        }
+    }
+
+    index->command_lut = command_lut;
+    index->command_lut_size = command_lut_size;
+    index->is_hashed = false;
+
+    if (command_lut_size > (CMD_API_INDEX_MAX_COMMANDS + 1U)) {
+        TRACE_WRN("%u commands, more than the index holds, using a linear scan\n", (unsigned int) (command_lut_size - 1U));
+
+        return true;
+    }
+
+    /* Duplicate commands always collide, the scan then runs the first one like the LUT order did before */
+    if (!CMD_API_TryIndex(index)) {
+        TRACE_WRN("No collision free hash for the command table, using a linear scan\n");
+
+        return true;
+    }
+
+    index->is_hashed = true;
+
+    return true;
+}
+
+eErrorCode_t CMD_API_FindCommand (sMessage_t command, sMessage_t *response, const sCmdIndex_t *index) {
+    if ((NULL == response) || (NULL == index) || (NULL == index->command_lut)) {
         TRACE_ERR("Invalid data pointer\n");
 
         return eErrorCode_NULLPTR;
@@ -60,21 +252,37 @@ eErrorCode_t CMD_API_FindCommand (sMessage_t command, sMessage_t *response, sCmd
 
         return eErrorCode_NULLPTR;
     }
-    
-    for (size_t command_number = 1; command_number < command_lut_size; command_number++) {
-        if (0 != strncmp(command.data, command_lut[command_number].command, command_lut[command_number].command_length)) {
-            continue;
+
+    if (NULL == command.data) {
+        Format_Print(response->data, response->size, "Invalid command\n");
+
+        return eErrorCode_NOTFOUND;
+    }
+
+    size_t token_length = 0;
+    uint32_t hash = CMD_API_HashToken(command.data, command.size, &token_length);
+    size_t command_number = 0;
+
+    if (index->is_hashed) {
+        command_number = index->slot[CMD_API_GetSlot(hash, index->displacement[hash % CMD_API_INDEX_BUCKETS])];
+
+        if ((0 != command_number) && ((token_length != index->command_lut[command_number].command_length) || (0 != memcmp(command.data, index->command_lut[command_number].command, token_length)))) {
+            command_number = 0;
         }
+    } else {
+        command_number = CMD_API_ScanCommand(command.data, token_length, index);
+    }
 
-        command.data += command_lut[command_number].command_length;
-        command.size -= command_lut[command_number].command_length;
+    if (0 == command_number) {
+        Format_Print(response->data, response->size, "Invalid command\n");
 
-        return command_lut[command_number].handler(command, response);
+        return eErrorCode_NOTFOUND;
     }
 
-    snprintf(response->data, response->size, "Invalid command\n");
+    command.data += token_length;
+    command.size -= token_length;
 
-    return eErrorCode_NOTFOUND;
+    return index->command_lut[command_number].handler(command, response);
 }
 
 #endif /* ENABLE_CMD */
@@ -9,6 +9,7 @@
 #if defined(ENABLE_CMD)
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "error_messages.h"
 #include "message.h"
 
@@ -16,6 +17,13 @@
  * Exported definitions and macros
  *********************************************************************************************************************/
 
+/* Commands hash into buckets and every bucket gets a displacement that moves its commands into free slots */
+#define CMD_API_INDEX_SLOTS 128U
+#define CMD_API_INDEX_BUCKETS 32U
+
+/* Half full slots leave every bucket plenty of free slots, larger tables are searched linearly */
+#define CMD_API_INDEX_MAX_COMMANDS (CMD_API_INDEX_SLOTS / 2U)
+
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
@@ -26,6 +34,15 @@ typedef struct sCmdDesc {
     eErrorCode_t (*handler)(sMessage_t arguments, sMessage_t *response);
 } sCmdDesc_t;
 
+/* Perfect hash over the command tokens of one LUT, every slot holds a LUT index and 0 marks an empty slot */
+typedef struct sCmdIndex {
+    sCmdDesc_t *command_lut;
+    size_t command_lut_size;
+    bool is_hashed;
+    uint8_t displacement[CMD_API_INDEX_BUCKETS];
+    uint8_t slot[CMD_API_INDEX_SLOTS];
+} sCmdIndex_t;
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -34,7 +51,8 @@ typedef struct sCmdDesc {
  * Prototypes of exported functions
  *********************************************************************************************************************/
 
-eErrorCode_t CMD_API_FindCommand (sMessage_t command, sMessage_t *response, sCmdDesc_t *command_lut, const size_t command_lut_size);
+bool CMD_API_BuildIndex (sCmdIndex_t *index, sCmdDesc_t *command_lut, const size_t command_lut_size);
+eErrorCode_t CMD_API_FindCommand (sMessage_t command, sMessage_t *response, const sCmdIndex_t *index);
 
 #endif /* ENABLE_CMD */
 #endif /* SOURCE_API_CMD_API_H_ */
@@ -5,14 +5,22 @@
 #include "cmd_api_helper.h"
 
 #if defined(ENABLE_CMD_HELPER)
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
-#include <stdio.h>
 #include <string.h>
+#include "format.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
+/* Below 2^24 the mantissa and the powers of ten up to 10^10 are exact floats, one division then rounds like strtof */
+#define CMD_API_HELPER_FLOAT_EXACT_MANTISSA (1UL << 24)
+#define CMD_API_HELPER_FLOAT_MAX_FRACTION 10U
+
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
@@ -21,6 +29,8 @@
  * Private constants
  *********************************************************************************************************************/
 
+static const float g_pow10_lut[CMD_API_HELPER_FLOAT_MAX_FRACTION + 1] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
@@ -33,10 +43,145 @@
  * Prototypes of private functions
  *********************************************************************************************************************/
 
+static eErrorCode_t CMD_API_Helper_AddArg (sCmdArgs_t *args, char *data, const size_t length, sMessage_t *response);
+static eErrorCode_t CMD_API_Helper_GetArg (const sCmdArgs_t *args, const size_t index, const sCmdArg_t **arg, sMessage_t *response);
+static eErrorCode_t CMD_API_Helper_ParseDigits (const sCmdArg_t *arg, const bool is_signed, size_t *magnitude, bool *is_negative, sMessage_t *response);
+static bool CMD_API_Helper_ParseFloat (const sCmdArg_t *arg, float *value);
+
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
+static eErrorCode_t CMD_API_Helper_AddArg (sCmdArgs_t *args, char *data, const size_t length, sMessage_t *response) {
+    if (args->count >= CMD_API_HELPER_MAX_ARGS) {
+        Format_Print(response->data, response->size, "Too many arguments\n");
+
+        return eErrorCode_ARGMANY;
+    }
+
+    args->arg[args->count].data = data;
+    args->arg[args->count].length = length;
+    args->count++;
+
+    return eErrorCode_OK;
+}
+
+static eErrorCode_t CMD_API_Helper_GetArg (const sCmdArgs_t *args, const size_t index, const sCmdArg_t **arg, sMessage_t *response) {
+    if ((NULL == args) || (NULL == arg) || (NULL == response)) {
+        return eErrorCode_NULLPTR;
+    }
+
+    if (index >= args->count) {
+        Format_Print(response->data, response->size, "Missing argument\n");
+
+        return eErrorCode_ARGFEW;
+    }
+
+    *arg = &args->arg[index];
+
+    return eErrorCode_OK;
+}
+
+/* Leading spaces and a sign like strtoul and strtol, but bounded by the slice and checked for overflow */
+static eErrorCode_t CMD_API_Helper_ParseDigits (const sCmdArg_t *arg, const bool is_signed, size_t *magnitude, bool *is_negative, sMessage_t *response) {
+    size_t position = 0;
+    size_t value = 0;
+
+    *is_negative = false;
+
+    while ((position < arg->length) && (' ' == arg->data[position])) {
+        position++;
+    }
+
+    if ((position < arg->length) && (('+' == arg->data[position]) || (is_signed && ('-' == arg->data[position])))) {
+        *is_negative = ('-' == arg->data[position]);
+        position++;
+    }
+
+    if (position == arg->length) {
+        Format_Print(response->data, response->size, "[%.*s]: Invalid argument; Use digits\n", (int) arg->length, arg->data);
+
+        return eErrorCode_INVAL;
+    }
+
+    for (; position < arg->length; position++) {
+        size_t digit = (size_t) (arg->data[position] - '0');
+
+        if (digit >= BASE_10) {
+            Format_Print(response->data, response->size, "[%.*s]: Invalid argument; Use digits\n", (int) arg->length, arg->data);
+
+            return eErrorCode_INVAL;
+        }
+
+        if (value > ((SIZE_MAX - digit) / BASE_10)) {
+            Format_Print(response->data, response->size, "[%.*s]: Argument out of range\n", (int) arg->length, arg->data);
+
+            return eErrorCode_RANGE;
+        }
+
+        value = (value * BASE_10) + digit;
+    }
+
+    *magnitude = value;
+
+    return eErrorCode_OK;
+}
+
+/* Plain decimals such as PID gains never reach strtof, which goes through soft double math on a single precision FPU */
+static bool CMD_API_Helper_ParseFloat (const sCmdArg_t *arg, float *value) {
+    size_t position = 0;
+    size_t digits = 0;
+    size_t fraction_digits = 0;
+    bool is_fraction = false;
+    bool is_negative = false;
+    uint32_t mantissa = 0;
+
+    while ((position < arg->length) && (' ' == arg->data[position])) {
+        position++;
+    }
+
+    if ((position < arg->length) && (('+' == arg->data[position]) || ('-' == arg->data[position]))) {
+        is_negative = ('-' == arg->data[position]);
+        position++;
+    }
+
+    for (; position < arg->length; position++) {
+        char character = arg->data[position];
+
+        if (('.' == character) && !is_fraction) {
+            is_fraction = true;
+
+            continue;
+        }
+
+        uint32_t digit = (uint32_t) (character - '0');
+
+        if (digit >= BASE_10) {
+            return false;
+        }
+
+        mantissa = (mantissa * BASE_10) + digit;
+        digits++;
+        fraction_digits += is_fraction ? 1U : 0U;
+
+        if ((mantissa >= CMD_API_HELPER_FLOAT_EXACT_MANTISSA) || (fraction_digits > CMD_API_HELPER_FLOAT_MAX_FRACTION)) {
+            return false;
+        }
+    }
+
+    if (0 == digits) {
+        return false;
+    }
+
+    *value = (float) mantissa / g_pow10_lut[fraction_digits];
+
+    if (is_negative) {
+        *value = -*value;
+    }
+
+    return true;
+}
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
@@ -47,7 +192,7 @@ eErrorCode_t CMD_API_Helper_ParseToken (char **token, sMessage_t *argument, char
     }
 
     if (0 == argument->size) {
-        snprintf(response->data, response->size, "Missing argument\n");
+        Format_Print(response->data, response->size, "Missing argument\n");
 
         return eErrorCode_ARGFEW;
     }
@@ -74,7 +219,7 @@ eErrorCode_t CMD_API_Helper_FindNextArgUInt (sMessage_t *argument, size_t *retur
     *return_argument = strtoul(argument->data, &invalid_character, BASE_10);
 
     if ('\0' != *invalid_character) {
-        snprintf(response->data, response->size, "[%s]: Invalid argument; Use digits separated by: '%s'\n", invalid_character, separator);
+        Format_Print(response->data, response->size, "[%s]: Invalid argument; Use digits separated by: '%s'\n", invalid_character, separator);
 
         return eErrorCode_INVAL;
     }
@@ -104,7 +249,7 @@ eErrorCode_t CMD_API_Helper_FindNextArgInt (sMessage_t *argument, int *return_ar
     *return_argument = strtol(argument->data, &invalid_character, BASE_10);
 
     if ('\0' != *invalid_character) {
-        snprintf(response->data, response->size, "[%s]: Invalid argument; Use digits separated by: '%s'\n", invalid_character, separator);
+        Format_Print(response->data, response->size, "[%s]: Invalid argument; Use digits separated by: '%s'\n", invalid_character, separator);
 
         return eErrorCode_INVAL;
     }
@@ -134,7 +279,7 @@ eErrorCode_t CMD_API_Helper_FindNextArgFloat (sMessage_t *argument, float *retur
     *return_argument = strtof(argument->data, &invalid_character);
 
     if ('\0' != *invalid_character) {
-        snprintf(response->data, response->size, "[%s]: Invalid argument; Use float separated by: '%s'\n", invalid_character, separator);
+        Format_Print(response->data, response->size, "[%s]: Invalid argument; Use float separated by: '%s'\n", invalid_character, separator);
 
         return eErrorCode_INVAL;
     }
@@ -174,4 +319,182 @@ eErrorCode_t CMD_API_Helper_FindNextArgChar (sMessage_t *argument, char *return_
     return eErrorCode_OK;
 }
 
+/* One pass, separators become '\0' so with the terminator UART_API_Receive leaves every slice is a C string */
+eErrorCode_t CMD_API_Helper_Tokenize (sMessage_t arguments, sCmdArgs_t *args, const char *separator, const size_t separator_length, sMessage_t *response) {
+    if ((NULL == args) || (NULL == separator) || (NULL == response)) {
+        return eErrorCode_NULLPTR;
+    }
+
+    if (0 == separator_length) {
+        return eErrorCode_INVAL;
+    }
+
+    args->count = 0;
+
+    if (0 == arguments.size) {
+        return eErrorCode_OK;
+    }
+
+    if (NULL == arguments.data) {
+        return eErrorCode_NULLPTR;
+    }
+
+    char *start = arguments.data;
+    char *position = arguments.data;
+    char *end = arguments.data + arguments.size;
+    eErrorCode_t error = eErrorCode_OK;
+
+    while ((size_t) (end - position) >= separator_length) {
+        if ((separator[0] != *position) || ((separator_length > 1) && (0 != memcmp(&position[1], &separator[1], separator_length - 1)))) {
+            position++;
+
+            continue;
+        }
+
+        error = CMD_API_Helper_AddArg(args, start, (size_t) (position - start), response);
+
+        if (eErrorCode_OK != error) {
+            return error;
+        }
+
+        *position = '\0';
+        position += separator_length;
+        start = position;
+    }
+
+    return CMD_API_Helper_AddArg(args, start, (size_t) (end - start), response);
+}
+
+eErrorCode_t CMD_API_Helper_CheckArgCount (const sCmdArgs_t *args, const size_t count, sMessage_t *response) {
+    if ((NULL == args) || (NULL == response)) {
+        return eErrorCode_NULLPTR;
+    }
+
+    if (args->count < count) {
+        Format_Print(response->data, response->size, "Missing argument\n");
+
+        return eErrorCode_ARGFEW;
+    }
+
+    if (args->count > count) {
+        Format_Print(response->data, response->size, "Too many arguments\n");
+
+        return eErrorCode_ARGMANY;
+    }
+
+    return eErrorCode_OK;
+}
+
+eErrorCode_t CMD_API_Helper_GetArgUInt (const sCmdArgs_t *args, const size_t index, size_t *return_argument, sMessage_t *response) {
+    const sCmdArg_t *arg = NULL;
+    size_t magnitude = 0;
+    bool is_negative = false;
+
+    if (NULL == return_argument) {
+        return eErrorCode_NULLPTR;
+    }
+
+    eErrorCode_t error = CMD_API_Helper_GetArg(args, index, &arg, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    error = CMD_API_Helper_ParseDigits(arg, false, &magnitude, &is_negative, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    *return_argument = magnitude;
+
+    return eErrorCode_OK;
+}
+
+eErrorCode_t CMD_API_Helper_GetArgInt (const sCmdArgs_t *args, const size_t index, int *return_argument, sMessage_t *response) {
+    const sCmdArg_t *arg = NULL;
+    size_t magnitude = 0;
+    bool is_negative = false;
+
+    if (NULL == return_argument) {
+        return eErrorCode_NULLPTR;
+    }
+
+    eErrorCode_t error = CMD_API_Helper_GetArg(args, index, &arg, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    error = CMD_API_Helper_ParseDigits(arg, true, &magnitude, &is_negative, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    if (magnitude > (is_negative ? ((size_t) INT_MAX + 1U) : (size_t) INT_MAX)) {
+        Format_Print(response->data, response->size, "[%.*s]: Argument out of range\n", (int) arg->length, arg->data);
+
+        return eErrorCode_RANGE;
+    }
+
+    *return_argument = is_negative ? (int) (0U - (unsigned int) magnitude) : (int) magnitude;
+
+    return eErrorCode_OK;
+}
+
+eErrorCode_t CMD_API_Helper_GetArgFloat (const sCmdArgs_t *args, const size_t index, float *return_argument, sMessage_t *response) {
+    const sCmdArg_t *arg = NULL;
+    char *invalid_character = NULL;
+
+    if (NULL == return_argument) {
+        return eErrorCode_NULLPTR;
+    }
+
+    eErrorCode_t error = CMD_API_Helper_GetArg(args, index, &arg, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    if (CMD_API_Helper_ParseFloat(arg, return_argument)) {
+        return eErrorCode_OK;
+    }
+
+    /* Exponents, long mantissas, inf and nan, or an invalid argument that strtof rejects below */
+    *return_argument = strtof(arg->data, &invalid_character);
+
+    if ((0 == arg->length) || (invalid_character != &arg->data[arg->length])) {
+        Format_Print(response->data, response->size, "[%.*s]: Invalid argument; Use float\n", (int) arg->length, arg->data);
+
+        return eErrorCode_INVAL;
+    }
+
+    return eErrorCode_OK;
+}
+
+eErrorCode_t CMD_API_Helper_GetArgChar (const sCmdArgs_t *args, const size_t index, char *return_argument, sMessage_t *response) {
+    const sCmdArg_t *arg = NULL;
+
+    if (NULL == return_argument) {
+        return eErrorCode_NULLPTR;
+    }
+
+    eErrorCode_t error = CMD_API_Helper_GetArg(args, index, &arg, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    if (1 != arg->length) {
+        Format_Print(response->data, response->size, "[%.*s]: Invalid argument; Use one character\n", (int) arg->length, arg->data);
+
+        return eErrorCode_INVAL;
+    }
+
+    *return_argument = arg->data[0];
+
+    return eErrorCode_OK;
+}
+
 #endif /* ENABLE_CMD_HELPER */
@@ -15,10 +15,25 @@
  * Exported definitions and macros
  *********************************************************************************************************************/
 
+/* Most arguments any default command takes, motors_setpid uses five */
+#define CMD_API_HELPER_MAX_ARGS 8U
+
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
 
+/* clang-format off */
+typedef struct sCmdArg {
+    char *data;
+    size_t length;
+} sCmdArg_t;
+
+typedef struct sCmdArgs {
+    size_t count;
+    sCmdArg_t arg[CMD_API_HELPER_MAX_ARGS];
+} sCmdArgs_t;
+/* clang-format on */
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -33,5 +48,12 @@ eErrorCode_t CMD_API_Helper_FindNextArgInt (sMessage_t *argument, int *return_ar
 eErrorCode_t CMD_API_Helper_FindNextArgFloat (sMessage_t *argument, float *return_argument, char *separator, const size_t separator_lenght, sMessage_t *response);
 eErrorCode_t CMD_API_Helper_FindNextArgChar (sMessage_t *argument, char *return_argument, char *separator, const size_t separator_lenght, sMessage_t *response);
 
+eErrorCode_t CMD_API_Helper_Tokenize (sMessage_t arguments, sCmdArgs_t *args, const char *separator, const size_t separator_length, sMessage_t *response);
+eErrorCode_t CMD_API_Helper_CheckArgCount (const sCmdArgs_t *args, const size_t count, sMessage_t *response);
+eErrorCode_t CMD_API_Helper_GetArgUInt (const sCmdArgs_t *args, const size_t index, size_t *return_argument, sMessage_t *response);
+eErrorCode_t CMD_API_Helper_GetArgInt (const sCmdArgs_t *args, const size_t index, int *return_argument, sMessage_t *response);
+eErrorCode_t CMD_API_Helper_GetArgFloat (const sCmdArgs_t *args, const size_t index, float *return_argument, sMessage_t *response);
+eErrorCode_t CMD_API_Helper_GetArgChar (const sCmdArgs_t *args, const size_t index, char *return_argument, sMessage_t *response);
+
 #endif /* ENABLE_CMD_HELPER */
 #endif /* SOURCE_API_CMD_API_HELPER_H_ */
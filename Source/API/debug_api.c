@@ -7,21 +7,95 @@
 #if defined(ENABLE_UART_DEBUG)
 
 #include "cmsis_os2.h"
+#include "rtos_api.h"
 #include "uart_api.h"
 #include "message.h"
 
+#if defined(DEBUG_DEFERRED)
+#include <stdatomic.h>
+#endif /* DEBUG_DEFERRED */
+
+#if defined(DEBUG_DEFERRED) || defined(DEBUG_FLIGHT_RECORDER)
+#include "ring_buffer.h"
+#endif /* DEBUG_DEFERRED || DEBUG_FLIGHT_RECORDER */
+
+#if defined(DEBUG_TIMESTAMP)
+#include "cycle_counter_driver.h"
+#endif /* DEBUG_TIMESTAMP */
+
+#if defined(DEBUG_TOKENIZED)
+#include "cobs.h"
+#else
+#include "format.h"
+#endif /* DEBUG_TOKENIZED */
+
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
+#if defined(DEBUG_DEFERRED)
+#define DEBUG_LOG_FLAG 0x01U
+#define DEBUG_LOG_RING_MASK (DEBUG_LOG_RING_CAPACITY - 1U)
+
+_Static_assert(RING_BUFFER_IS_POWER_OF_TWO(DEBUG_LOG_RING_CAPACITY), "DEBUG_LOG_RING_CAPACITY must be a power of two");
+#endif /* DEBUG_DEFERRED */
+
+#if defined(DEBUG_FLIGHT_RECORDER)
+/* Must be a NOLOAD output section in the linker script, so the recorder is neither zeroed nor loaded at start up */
+#define DEBUG_RECORDER_SECTION ".noinit"
+#define DEBUG_RECORDER_MAGIC 0x54524543UL
+#define DEBUG_RECORDER_MASK (DEBUG_RECORDER_CAPACITY - 1U)
+
+_Static_assert(RING_BUFFER_IS_POWER_OF_TWO(DEBUG_RECORDER_CAPACITY), "DEBUG_RECORDER_CAPACITY must be a power of two");
+_Static_assert(DEBUG_RECORDER_CAPACITY >= (DEBUG_MESSAGE_SIZE + sizeof(uint16_t)), "DEBUG_RECORDER_CAPACITY must hold a DEBUG_MESSAGE_SIZE record");
+#endif /* DEBUG_FLIGHT_RECORDER */
+
+#if defined(DEBUG_TOKENIZED)
+/* Tokens are 16 bit offsets into DEBUG_TOKEN_SECTION below this value, which limits the section to 0xFFFE bytes */
+#define DEBUG_TOKEN_NONE 0xFFFFU
+#define DEBUG_TOKEN_TRUNCATED_FLAG 0x80U
+/* Set when a u32 cycle count follows the module token */
+#define DEBUG_TOKEN_TIMESTAMP_FLAG 0x40U
+#define DEBUG_TOKEN_STRING_MAX_LENGTH UINT8_MAX
+/* Leading and trailing 0x00 delimiters, so the decoder can tell frames apart from plain text on the same UART */
+#define DEBUG_TOKEN_FRAME_OVERHEAD 2U
+
+_Static_assert((COBS_MAX_ENCODED_SIZE(DEBUG_TOKEN_PAYLOAD_SIZE) + DEBUG_TOKEN_FRAME_OVERHEAD) <= DEBUG_MESSAGE_SIZE, "DEBUG_MESSAGE_SIZE must hold an encoded DEBUG_TOKEN_PAYLOAD_SIZE frame");
+#endif /* DEBUG_TOKENIZED */
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
 
+#if defined(DEBUG_DEFERRED)
+/* clang-format off */
+typedef struct sDebugLogRecord {
+    atomic_size_t sequence;
+    bool is_recorded;
+    size_t size;
+    char data[DEBUG_MESSAGE_SIZE];
+} sDebugLogRecord_t;
+/* clang-format on */
+#endif /* DEBUG_DEFERRED */
+
+#if defined(DEBUG_FLIGHT_RECORDER)
+/* clang-format off */
+typedef struct sDebugRecorder {
+    uint32_t magic;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    char data[DEBUG_RECORDER_CAPACITY];
+} sDebugRecorder_t;
+/* clang-format on */
+#endif /* DEBUG_FLIGHT_RECORDER */
+
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
 
+/* Debug_API traces itself without a module, the file name still goes in once like CREATE_MODULE_NAME does it */
+static const char g_debug_file_name[] TRACE_FILE_STRING = __FILE__;
+
 static const osMutexAttr_t g_debug_api_mutex_attributes = {
     .name = "Debug_API_mutex", 
     .attr_bits = osMutexRecursive | osMutexPrioInherit, 
@@ -29,6 +103,14 @@ static const osMutexAttr_t g_debug_api_mutex_attributes = {
     .cb_size = 0U
 };
 
+#if defined(DEBUG_DEFERRED)
+static const osThreadAttr_t g_debug_log_thread_attributes = {
+    .name = "Debug_API_LogThread",
+    .stack_size = DEBUG_LOG_THREAD_STACK_SIZE,
+    .priority = (osPriority_t) DEBUG_LOG_THREAD_PRIORITY
+};
+#endif /* DEBUG_DEFERRED */
+
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
@@ -37,18 +119,534 @@ static char g_debug_message_buffer[DEBUG_MESSAGE_SIZE] = {0};
 static bool g_is_initialized = false;
 static osMutexId_t g_debug_api_mutex = NULL;
 
+#if defined(DEBUG_DEFERRED)
+/* Bounded MPMC sequence ring, a record is free at sequence == position and ready at sequence == position + 1 */
+static sDebugLogRecord_t g_log_ring[DEBUG_LOG_RING_CAPACITY] = {0};
+static atomic_size_t g_log_head = 0;
+static size_t g_log_tail = 0;
+static atomic_uint_least32_t g_log_dropped = 0;
+static uint32_t g_log_reported_dropped = 0;
+static osThreadId_t g_log_thread_id = NULL;
+#endif /* DEBUG_DEFERRED */
+
+#if defined(DEBUG_FLIGHT_RECORDER)
+/* Byte ring of u16 length prefixed records, head and tail are free running byte positions, kept across resets */
+static sDebugRecorder_t g_recorder __attribute__((section(DEBUG_RECORDER_SECTION)));
+#endif /* DEBUG_FLIGHT_RECORDER */
+
 /**********************************************************************************************************************
  * Exported variables and references
  *********************************************************************************************************************/
 
+/* Provided by the linker for DEBUG_MODULE_SECTION, weak so a build without any CREATE_MODULE_NAME still links */
+extern const sTraceModule_t __start_trace_modules[] __attribute__((weak));
+extern const sTraceModule_t __stop_trace_modules[] __attribute__((weak));
+
+#if defined(DEBUG_TOKENIZED)
+/* Provided by the linker for the orphan DEBUG_TOKEN_SECTION, define it in the linker script when placing the section by hand */
+extern const char __start_trace_fmt[];
+#endif /* DEBUG_TOKENIZED */
+
 /**********************************************************************************************************************
  * Prototypes of private functions
  *********************************************************************************************************************/
  
+#if defined(DEBUG_TOKENIZED)
+static uint16_t Debug_API_GetToken (const char *string);
+static bool Debug_API_PutBytes (uint8_t *payload, size_t *position, const void *data, const size_t size);
+#endif /* DEBUG_TOKENIZED */
+static uint32_t Debug_API_GetTimestamp (void);
+static size_t Debug_API_Format (char *buffer, const size_t size, const uint32_t timestamp, const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, va_list arguments);
+#if defined(DEBUG_DEFERRED)
+static size_t Debug_API_FormatRecord (char *buffer, const size_t size, const uint32_t timestamp, const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, ...);
+static sDebugLogRecord_t *Debug_API_ReserveRecord (void);
+static void Debug_API_CommitRecord (sDebugLogRecord_t *record);
+static bool Debug_API_DrainRecord (void);
+static void Debug_API_ReportDropped (void);
+static void Debug_API_LogThread (void *arg);
+#endif /* DEBUG_DEFERRED */
+#if defined(DEBUG_FLIGHT_RECORDER)
+static void Debug_API_RecorderPut (const uint32_t position, const void *data, const size_t size);
+static void Debug_API_RecorderGet (const uint32_t position, void *data, const size_t size);
+static bool Debug_API_RecorderIsValid (void);
+static void Debug_API_RecorderWrite (const char *data, const size_t size);
+#endif /* DEBUG_FLIGHT_RECORDER */
+static bool Debug_API_Send (const sMessage_t message, const bool is_recorded);
+static bool Debug_API_VPrint (const bool is_recorded, const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, va_list arguments);
+
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
  
+/* Without DEBUG_TIMESTAMP the line carries no timestamp and the value is not used */
+static uint32_t Debug_API_GetTimestamp (void) {
+    #if defined(DEBUG_TIMESTAMP)
+    return Cycle_Counter_Driver_GetCycles();
+    #else
+    return 0;
+    #endif /* DEBUG_TIMESTAMP */
+}
+
+#if defined(DEBUG_TOKENIZED)
+/* A string past the 16 bit range is sent as none rather than as a wrapped offset naming another string */
+static uint16_t Debug_API_GetToken (const char *string) {
+    if (NULL == string) {
+        return DEBUG_TOKEN_NONE;
+    }
+
+    uintptr_t offset = (uintptr_t) string - (uintptr_t) __start_trace_fmt;
+
+    if (offset >= DEBUG_TOKEN_NONE) {
+        return DEBUG_TOKEN_NONE;
+    }
+
+    return (uint16_t) offset;
+}
+
+static bool Debug_API_PutBytes (uint8_t *payload, size_t *position, const void *data, const size_t size) {
+    if ((*position + size) > DEBUG_TOKEN_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    memcpy(&payload[*position], data, size);
+    *position += size;
+
+    return true;
+}
+
+/* Encodes level, string tokens and the raw arguments in format order, the host decoder does the formatting */
+static size_t Debug_API_Format (char *buffer, const size_t size, const uint32_t timestamp, const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, va_list arguments) {
+    uint8_t payload[DEBUG_TOKEN_PAYLOAD_SIZE] = {0};
+    size_t position = 0;
+
+    uint8_t level = (uint8_t) trace_level;
+    uint16_t format_token = Debug_API_GetToken(format);
+    uint16_t module_token = Debug_API_GetToken(file_trace);
+
+    #if defined(DEBUG_TIMESTAMP)
+    level |= DEBUG_TOKEN_TIMESTAMP_FLAG;
+    #endif /* DEBUG_TIMESTAMP */
+
+    Debug_API_PutBytes(payload, &position, &level, sizeof(level));
+    Debug_API_PutBytes(payload, &position, &format_token, sizeof(format_token));
+    Debug_API_PutBytes(payload, &position, &module_token, sizeof(module_token));
+
+    #if defined(DEBUG_TIMESTAMP)
+    Debug_API_PutBytes(payload, &position, &timestamp, sizeof(timestamp));
+    #endif /* DEBUG_TIMESTAMP */
+
+    if (eTraceLevel_Error == trace_level) {
+        uint16_t file_token = Debug_API_GetToken(file_name);
+        uint16_t line = (uint16_t) line_number;
+
+        Debug_API_PutBytes(payload, &position, &file_token, sizeof(file_token));
+        Debug_API_PutBytes(payload, &position, &line, sizeof(line));
+    }
+
+    bool is_truncated = false;
+
+    for (const char *character = format; ('\0' != *character) && !is_truncated; character++) {
+        if ('%' != *character) {
+            continue;
+        }
+
+        character++;
+
+        // Flags, width and precision only shape the text, a '*' takes an int argument of its own
+        while (('\0' != *character) && (NULL != strchr("-+ #0123456789.*", *character))) {
+            if ('*' == *character) {
+                int32_t value = (int32_t) va_arg(arguments, int);
+
+                is_truncated |= !Debug_API_PutBytes(payload, &position, &value, sizeof(value));
+            }
+
+            character++;
+        }
+
+        size_t long_count = 0;
+        bool is_max = false;
+        bool is_size = false;
+
+        while (('\0' != *character) && (NULL != strchr("hlLzjt", *character))) {
+            if ('l' == *character) {
+                long_count++;
+            } else if ('j' == *character) {
+                is_max = true;
+            } else if ('h' != *character) {
+                is_size = true;
+            }
+
+            character++;
+        }
+
+        switch (*character) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'c': {
+                // intmax_t is 64 bit like long long, the decoder reads 8 bytes for both
+                if ((long_count >= 2) || is_max) {
+                    uint64_t value = is_max ? (uint64_t) va_arg(arguments, uintmax_t) : (uint64_t) va_arg(arguments, unsigned long long);
+
+                    is_truncated |= !Debug_API_PutBytes(payload, &position, &value, sizeof(value));
+                } else {
+                    uint32_t value = 0;
+
+                    if (1 == long_count) {
+                        value = (uint32_t) va_arg(arguments, unsigned long);
+                    } else if (is_size) {
+                        value = (uint32_t) va_arg(arguments, size_t);
+                    } else {
+                        value = (uint32_t) va_arg(arguments, unsigned int);
+                    }
+
+                    is_truncated |= !Debug_API_PutBytes(payload, &position, &value, sizeof(value));
+                }
+            } break;
+            case 'p': {
+                uint32_t value = (uint32_t) (uintptr_t) va_arg(arguments, void*);
+
+                is_truncated |= !Debug_API_PutBytes(payload, &position, &value, sizeof(value));
+            } break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G': {
+                double value = va_arg(arguments, double);
+
+                is_truncated |= !Debug_API_PutBytes(payload, &position, &value, sizeof(value));
+            } break;
+            case 's': {
+                const char *string = va_arg(arguments, const char*);
+
+                if (NULL == string) {
+                    string = "(null)";
+                }
+
+                uint8_t length = (uint8_t) strnlen(string, DEBUG_TOKEN_STRING_MAX_LENGTH);
+                size_t space = DEBUG_TOKEN_PAYLOAD_SIZE - position;
+
+                if (space <= sizeof(length)) {
+                    is_truncated = true;
+
+                    break;
+                }
+
+                // A long string is cut to the space left, the arguments after it are dropped
+                if ((sizeof(length) + length) > space) {
+                    length = (uint8_t) (space - sizeof(length));
+                    is_truncated = true;
+                }
+
+                Debug_API_PutBytes(payload, &position, &length, sizeof(length));
+                Debug_API_PutBytes(payload, &position, string, length);
+            } break;
+            case '\0': {
+                character--;
+            } break;
+            default: {
+            } break;
+        }
+    }
+
+    // The decoder stops at the first argument that did not fit
+    if (is_truncated) {
+        payload[0] |= DEBUG_TOKEN_TRUNCATED_FLAG;
+    }
+
+    size_t encoded_size = 0;
+
+    if (size < DEBUG_TOKEN_FRAME_OVERHEAD) {
+        return 0;
+    }
+
+    if (!COBS_Encode(payload, position, (uint8_t*) &buffer[1], (size - DEBUG_TOKEN_FRAME_OVERHEAD), &encoded_size)) {
+        return 0;
+    }
+
+    buffer[0] = 0x00;
+    buffer[encoded_size + 1] = 0x00;
+
+    return (encoded_size + DEBUG_TOKEN_FRAME_OVERHEAD);
+}
+#else
+/* Never writes past size, a line that does not fit is truncated */
+static size_t Debug_API_Format (char *buffer, const size_t size, const uint32_t timestamp, const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, va_list arguments) {
+    size_t length = 0;
+
+    #if defined(DEBUG_TIMESTAMP)
+    length = Format_Print(buffer, size, "@%lu ", (unsigned long) timestamp);
+    #endif /* DEBUG_TIMESTAMP */
+
+    switch (trace_level) {
+        case eTraceLevel_Info: {
+            length += Format_Print((buffer + length), (size - length), "[%s.INF] ", file_trace);
+        } break;
+        case eTraceLevel_Warning: {
+            length += Format_Print((buffer + length), (size - length), "[%s.WRN] ", file_trace);
+        } break;
+        case eTraceLevel_Error: {
+            length += Format_Print((buffer + length), (size - length), "[%s.ERR] (file: %s, line: %u) ", file_trace, file_name, (unsigned int) line_number);
+        } break;
+        default: {
+        } break;
+    }
+
+    return length + Format_VPrint((buffer + length), (size - length), format, arguments);
+}
+#endif /* DEBUG_TOKENIZED */
+
+#if defined(DEBUG_DEFERRED)
+static size_t Debug_API_FormatRecord (char *buffer, const size_t size, const uint32_t timestamp, const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, ...) {
+    va_list arguments;
+
+    va_start(arguments, format);
+
+    size_t length = Debug_API_Format(buffer, size, timestamp, trace_level, file_trace, file_name, line_number, format, arguments);
+
+    va_end(arguments);
+
+    return length;
+}
+#endif /* DEBUG_DEFERRED */
+
+#if defined(DEBUG_DEFERRED)
+/* Lock-free claim of the next free record, safe from threads and interrupts, NULL when the ring is full */
+static sDebugLogRecord_t *Debug_API_ReserveRecord (void) {
+    size_t position = atomic_load_explicit(&g_log_head, memory_order_relaxed);
+
+    while (true) {
+        sDebugLogRecord_t *record = &g_log_ring[position & DEBUG_LOG_RING_MASK];
+        size_t sequence = atomic_load_explicit(&record->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+
+        if (0 == difference) {
+            if (atomic_compare_exchange_weak_explicit(&g_log_head, &position, (position + 1), memory_order_relaxed, memory_order_relaxed)) {
+                return record;
+            }
+        } else if (difference < 0) {
+            return NULL;
+        } else {
+            position = atomic_load_explicit(&g_log_head, memory_order_relaxed);
+        }
+    }
+}
+
+static void Debug_API_CommitRecord (sDebugLogRecord_t *record) {
+    atomic_fetch_add_explicit(&record->sequence, 1, memory_order_release);
+
+    osThreadFlagsSet(g_log_thread_id, DEBUG_LOG_FLAG);
+
+    return;
+}
+
+/* Sends the oldest record, stops at a record still being written so lines keep their order */
+static bool Debug_API_DrainRecord (void) {
+    sDebugLogRecord_t *record = &g_log_ring[g_log_tail & DEBUG_LOG_RING_MASK];
+
+    if ((g_log_tail + 1) != atomic_load_explicit(&record->sequence, memory_order_acquire)) {
+        return false;
+    }
+
+    sMessage_t message = {.data = record->data, .size = record->size};
+
+    if (!Debug_API_Send(message, record->is_recorded)) {
+        atomic_fetch_add_explicit(&g_log_dropped, 1, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&record->sequence, (g_log_tail + DEBUG_LOG_RING_CAPACITY), memory_order_release);
+    g_log_tail++;
+
+    return true;
+}
+
+static void Debug_API_ReportDropped (void) {
+    uint32_t dropped = atomic_load_explicit(&g_log_dropped, memory_order_relaxed);
+
+    if (dropped == g_log_reported_dropped) {
+        return;
+    }
+
+    sMessage_t message = {.data = g_debug_message_buffer, .size = 0};
+
+    message.size = Debug_API_FormatRecord(message.data, DEBUG_MESSAGE_SIZE, Debug_API_GetTimestamp(), eTraceLevel_Warning, TRACE_STRING("DEBUG_API"), g_debug_file_name, __LINE__, TRACE_STRING("%lu lines dropped\n"), (unsigned long) (dropped - g_log_reported_dropped));
+
+    if (0 != message.size) {
+        Debug_API_Send(message, true);
+    }
+
+    g_log_reported_dropped = dropped;
+
+    return;
+}
+
+static void Debug_API_LogThread (void *arg) {
+    while (1) {
+        osThreadFlagsWait(DEBUG_LOG_FLAG, osFlagsWaitAny, osWaitForever);
+
+        while (Debug_API_DrainRecord()) {}
+
+        Debug_API_ReportDropped();
+    }
+
+    osThreadYield();
+}
+#endif /* DEBUG_DEFERRED */
+
+#if defined(DEBUG_FLIGHT_RECORDER)
+static void Debug_API_RecorderPut (const uint32_t position, const void *data, const size_t size) {
+    size_t index = position & DEBUG_RECORDER_MASK;
+    size_t first_size = ((DEBUG_RECORDER_CAPACITY - index) < size) ? (DEBUG_RECORDER_CAPACITY - index) : size;
+
+    memcpy(&g_recorder.data[index], data, first_size);
+    memcpy(g_recorder.data, ((const char *) data + first_size), (size - first_size));
+
+    return;
+}
+
+static void Debug_API_RecorderGet (const uint32_t position, void *data, const size_t size) {
+    size_t index = position & DEBUG_RECORDER_MASK;
+    size_t first_size = ((DEBUG_RECORDER_CAPACITY - index) < size) ? (DEBUG_RECORDER_CAPACITY - index) : size;
+
+    memcpy(data, &g_recorder.data[index], first_size);
+    memcpy(((char *) data + first_size), g_recorder.data, (size - first_size));
+
+    return;
+}
+
+/* RAM content after a power cycle is random, only a recorder whose records add up exactly is kept */
+static bool Debug_API_RecorderIsValid (void) {
+    if (DEBUG_RECORDER_MAGIC != g_recorder.magic) {
+        return false;
+    }
+
+    if ((g_recorder.head - g_recorder.tail) > DEBUG_RECORDER_CAPACITY) {
+        return false;
+    }
+
+    uint32_t position = g_recorder.tail;
+
+    while (position != g_recorder.head) {
+        uint16_t record_size = 0;
+
+        if ((g_recorder.head - position) < sizeof(record_size)) {
+            return false;
+        }
+
+        Debug_API_RecorderGet(position, &record_size, sizeof(record_size));
+        position += sizeof(record_size);
+
+        if ((0 == record_size) || (record_size > DEBUG_MESSAGE_SIZE) || ((g_recorder.head - position) < record_size)) {
+            return false;
+        }
+
+        position += record_size;
+    }
+
+    return true;
+}
+
+/* Overwrites the oldest records when full, head moves last so a reset mid-write only loses the line being written */
+static void Debug_API_RecorderWrite (const char *data, const size_t size) {
+    uint16_t record_size = (uint16_t) size;
+    uint32_t needed = sizeof(record_size) + record_size;
+
+    while ((DEBUG_RECORDER_CAPACITY - (g_recorder.head - g_recorder.tail)) < needed) {
+        uint16_t oldest_size = 0;
+
+        Debug_API_RecorderGet(g_recorder.tail, &oldest_size, sizeof(oldest_size));
+        g_recorder.tail += sizeof(oldest_size) + oldest_size;
+    }
+
+    Debug_API_RecorderPut(g_recorder.head, &record_size, sizeof(record_size));
+    Debug_API_RecorderPut((g_recorder.head + sizeof(record_size)), data, record_size);
+
+    g_recorder.head += needed;
+
+    return;
+}
+#endif /* DEBUG_FLIGHT_RECORDER */
+
+/* Hands a formatted line to the sink, the flight recorder when enabled, the debug UART otherwise */
+/* is_recorded false sends the line over the UART also with DEBUG_FLIGHT_RECORDER */
+static bool Debug_API_Send (const sMessage_t message, const bool is_recorded) {
+    #if defined(DEBUG_FLIGHT_RECORDER)
+    if (!is_recorded) {
+        return UART_API_Send(DEBUG_UART, message, DEBUG_MESSAGE_TIMEOUT);
+    }
+
+    if (0 == message.size) {
+        return true;
+    }
+
+    if (osOK != osMutexAcquire(g_debug_api_mutex, DEBUG_MUTEX_TIMEOUT)) {
+        return false;
+    }
+
+    Debug_API_RecorderWrite(message.data, message.size);
+
+    osMutexRelease(g_debug_api_mutex);
+
+    return true;
+    #else
+    return UART_API_Send(DEBUG_UART, message, DEBUG_MESSAGE_TIMEOUT);
+    #endif /* DEBUG_FLIGHT_RECORDER */
+}
+
+/* With DEBUG_DEFERRED the line is only formatted into the log ring, so it may be called from interrupts */
+static bool Debug_API_VPrint (const bool is_recorded, const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, va_list arguments) {
+    if ((trace_level < eTraceLevel_First) || (trace_level >= eTraceLevel_Last)) {
+        return false;
+    }
+
+    if ((NULL == file_trace) || (NULL == format) || (NULL == file_name)) {
+        return false;
+    }
+
+    /* Read before the record is reserved, an interrupt tracing in between would otherwise go out of time order */
+    uint32_t timestamp = Debug_API_GetTimestamp();
+
+    #if defined(DEBUG_DEFERRED)
+    if (!g_is_initialized) {
+        return false;
+    }
+
+    sDebugLogRecord_t *record = Debug_API_ReserveRecord();
+
+    if (NULL == record) {
+        atomic_fetch_add_explicit(&g_log_dropped, 1, memory_order_relaxed);
+
+        return false;
+    }
+
+    record->is_recorded = is_recorded;
+    record->size = Debug_API_Format(record->data, DEBUG_MESSAGE_SIZE, timestamp, trace_level, file_trace, file_name, line_number, format, arguments);
+
+    Debug_API_CommitRecord(record);
+
+    return true;
+    #else
+    if (osOK != osMutexAcquire(g_debug_api_mutex, DEBUG_MUTEX_TIMEOUT)) {
+        return false;
+    }
+
+    sMessage_t debug_message = {.data = g_debug_message_buffer, .size = 0};
+
+    debug_message.size = Debug_API_Format(debug_message.data, DEBUG_MESSAGE_SIZE, timestamp, trace_level, file_trace, file_name, line_number, format, arguments);
+
+    bool is_sent = Debug_API_Send(debug_message, is_recorded);
+
+    osMutexRelease(g_debug_api_mutex);
+
+    return is_sent;
+    #endif /* DEBUG_DEFERRED */
+}
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
@@ -57,68 +655,192 @@ bool Debug_API_Init (const eBaudrate_t baudrate) {
     if (g_is_initialized) {
         return false;
     }
-    
+
     if ((baudrate < eBaudrate_First) || (baudrate >= eBaudrate_Last)) {
         return false;
     }
 
-    g_debug_api_mutex = osMutexNew(&g_debug_api_mutex_attributes);
+    g_debug_api_mutex = RTOS_API_MutexNew(&g_debug_api_mutex_attributes);
 
     if (NULL == g_debug_api_mutex) {
         return false;
     }
 
-    g_is_initialized = UART_API_Init(DEBUG_UART, baudrate, DEBUG_DELIMITER);
+    if (!UART_API_Init(DEBUG_UART, baudrate, DEBUG_DELIMITER)) {
+        return false;
+    }
+
+    #if defined(DEBUG_TIMESTAMP)
+    if (!Cycle_Counter_Driver_Init()) {
+        return false;
+    }
+    #endif /* DEBUG_TIMESTAMP */
+
+    #if defined(DEBUG_FLIGHT_RECORDER)
+    bool is_recorder_kept = Debug_API_RecorderIsValid();
+
+    if (!is_recorder_kept) {
+        g_recorder.head = 0;
+        g_recorder.tail = 0;
+        g_recorder.magic = DEBUG_RECORDER_MAGIC;
+    }
+    #endif /* DEBUG_FLIGHT_RECORDER */
+
+    #if defined(DEBUG_DEFERRED)
+    for (size_t record = 0; record < DEBUG_LOG_RING_CAPACITY; record++) {
+        atomic_init(&g_log_ring[record].sequence, record);
+    }
+
+    g_log_thread_id = RTOS_API_ThreadNew(Debug_API_LogThread, NULL, &g_debug_log_thread_attributes);
+
+    if (NULL == g_log_thread_id) {
+        return false;
+    }
+    #endif /* DEBUG_DEFERRED */
+
+    g_is_initialized = true;
+
+    #if defined(DEBUG_FLIGHT_RECORDER)
+    if (is_recorder_kept) {
+        Debug_API_Print(eTraceLevel_Warning, TRACE_STRING("DEBUG_API"), g_debug_file_name, __LINE__, TRACE_STRING("Reset, %lu recorder bytes kept\n"), (unsigned long) (g_recorder.head - g_recorder.tail));
+    }
+    #endif /* DEBUG_FLIGHT_RECORDER */
 
     return g_is_initialized;
 }
 
 bool Debug_API_Print (const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, ...) {
-    if ((trace_level < eTraceLevel_First) || (trace_level >= eTraceLevel_Last)) {
+    va_list arguments;
+
+    va_start(arguments, format);
+
+    bool is_printed = Debug_API_VPrint(true, trace_level, file_trace, file_name, line_number, format, arguments);
+
+    va_end(arguments);
+
+    return is_printed;
+}
+
+/* Like Debug_API_Print, but the line bypasses the flight recorder so the CLI answers over the UART */
+bool Debug_API_PrintCli (const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, ...) {
+    va_list arguments;
+
+    va_start(arguments, format);
+
+    bool is_printed = Debug_API_VPrint(false, trace_level, file_trace, file_name, line_number, format, arguments);
+
+    va_end(arguments);
+
+    return is_printed;
+}
+
+bool Debug_API_GetDroppedCount (uint32_t *dropped) {
+    if (NULL == dropped) {
         return false;
     }
 
-    if ((NULL == file_trace) || (NULL == format) || (NULL == file_name)) {
+    #if defined(DEBUG_DEFERRED)
+    *dropped = atomic_load_explicit(&g_log_dropped, memory_order_relaxed);
+    #else
+    *dropped = 0;
+    #endif /* DEBUG_DEFERRED */
+
+    return true;
+}
+
+/* DEBUG_ALL_MODULES applies the level to every module, eTraceLevel_Last silences a module */
+bool Debug_API_SetModuleLevel (const char *module_name, const eTraceLevel_t trace_level) {
+    if (NULL == module_name) {
         return false;
     }
 
-    if (osOK != osMutexAcquire(g_debug_api_mutex, DEBUG_MUTEX_TIMEOUT)) {
+    if ((trace_level < eTraceLevel_First) || (trace_level > eTraceLevel_Last)) {
         return false;
     }
 
-    static sMessage_t debug_message = {.data = NULL, .size = 0};
-    static size_t message_length = 0;
+    bool is_all = (0 == strcmp(module_name, DEBUG_ALL_MODULES));
+    bool is_found = false;
 
-    va_list arguments;
-    
-    debug_message.data = g_debug_message_buffer;
+    for (const sTraceModule_t *module = __start_trace_modules; module < __stop_trace_modules; module++) {
+        if (!is_all && (0 != strcmp(module_name, module->name))) {
+            continue;
+        }
 
-    switch (trace_level) {
-        case eTraceLevel_Info: {
-            message_length = sprintf(debug_message.data, "[%s.INF] ", file_trace);
-        } break;
-        case eTraceLevel_Warning: {
-            message_length = sprintf(debug_message.data, "[%s.WRN] ", file_trace);
-        } break;
-        case eTraceLevel_Error: {
-            message_length = sprintf(debug_message.data, "[%s.ERR] (file: %s, line: %d) ", file_trace, file_name, line_number);
-        } break;
-        default: {
-        } break;
+        *module->level = trace_level;
+        is_found = true;
     }
 
-    va_start(arguments, format);
+    return is_found;
+}
 
-    message_length += vsprintf((debug_message.data + message_length), format, arguments);
+#if defined(DEBUG_FLIGHT_RECORDER)
+/* Sends the lines recorded before the call oldest first, the mutex is only held to copy a line out so traces go on */
+bool Debug_API_DumpRecorder (void) {
+    if (!g_is_initialized) {
+        return false;
+    }
+
+    if (osOK != osMutexAcquire(g_debug_api_mutex, DEBUG_MUTEX_TIMEOUT)) {
+        return false;
+    }
+
+    uint32_t position = g_recorder.tail;
+    uint32_t end = g_recorder.head;
 
-    va_end(arguments);
-    
-    debug_message.size = message_length;
-    bool is_sent = UART_API_Send(DEBUG_UART, debug_message, DEBUG_MESSAGE_TIMEOUT);
-    
     osMutexRelease(g_debug_api_mutex);
 
+    char record[DEBUG_MESSAGE_SIZE];
+    bool is_sent = true;
+
+    while (is_sent && (position != end)) {
+        if (osOK != osMutexAcquire(g_debug_api_mutex, DEBUG_MUTEX_TIMEOUT)) {
+            return false;
+        }
+
+        uint32_t kept_size = g_recorder.head - g_recorder.tail;
+
+        /* Lines overwritten while the previous ones were sent are skipped, the dump goes on from the oldest kept line */
+        if ((position - g_recorder.tail) > kept_size) {
+            position = g_recorder.tail;
+        }
+
+        if (((end - g_recorder.tail) > kept_size) || (position == end)) {
+            osMutexRelease(g_debug_api_mutex);
+
+            break;
+        }
+
+        uint16_t record_size = 0;
+
+        Debug_API_RecorderGet(position, &record_size, sizeof(record_size));
+        Debug_API_RecorderGet((position + sizeof(record_size)), record, record_size);
+        position += sizeof(record_size) + record_size;
+
+        osMutexRelease(g_debug_api_mutex);
+
+        sMessage_t message = {.data = record, .size = record_size};
+
+        is_sent = UART_API_Send(DEBUG_UART, message, DEBUG_MESSAGE_TIMEOUT);
+    }
+
     return is_sent;
 }
 
+bool Debug_API_ClearRecorder (void) {
+    if (!g_is_initialized) {
+        return false;
+    }
+
+    if (osOK != osMutexAcquire(g_debug_api_mutex, DEBUG_MUTEX_TIMEOUT)) {
+        return false;
+    }
+
+    g_recorder.tail = g_recorder.head;
+
+    osMutexRelease(g_debug_api_mutex);
+
+    return true;
+}
+#endif /* DEBUG_FLIGHT_RECORDER */
+
 #endif /* ENABLE_UART_DEBUG */
@@ -18,19 +18,69 @@
  * Exported definitions and macros
  *********************************************************************************************************************/
 
-#define CREATE_MODULE_NAME(file_name) static const char *trace_module_name = #file_name;
-#define CREATE_MODULE_NAME_EMPTY static const char *trace_module_name __attribute__((unused)) = NULL;
+/* Compile time threshold, traces below TRACE_LEVEL_MIN are folded away together with their arguments */
+#if defined(TRACE_LEVEL_MIN)
+#define TRACE_IS_COMPILED(level) ((level) >= TRACE_LEVEL_MIN)
+#else
+#define TRACE_IS_COMPILED(level) (true)
+#endif /* TRACE_LEVEL_MIN */
+
+/* Checked before the arguments are evaluated, so a filtered trace costs one load and compare */
+#define TRACE_IS_ENABLED(level) (TRACE_IS_COMPILED(level) && ((level) >= trace_module_level))
+
+/* Every CREATE_MODULE_NAME registers its runtime level here, Debug_API_SetModuleLevel walks the section */
+#define DEBUG_MODULE_SECTION "trace_modules"
+#define DEBUG_ALL_MODULES "all"
+
+#if defined(DEBUG_TOKENIZED)
+/* Trace strings go to their own section and are sent as offsets into it, Tools/trace_decoder.py reads them from the ELF */
+#define DEBUG_TOKEN_SECTION "trace_fmt"
+#define TRACE_STRING(string) ({ static const char trace_string[] __attribute__((section(DEBUG_TOKEN_SECTION))) = string; trace_string; })
+
+#define TRACE_MODULE_STRING __attribute__((section(DEBUG_TOKEN_SECTION), used))
+#define TRACE_FILE_STRING __attribute__((section(DEBUG_TOKEN_SECTION), unused))
+#else
+#define TRACE_STRING(string) (string)
+
+#define TRACE_MODULE_STRING
+#define TRACE_FILE_STRING __attribute__((unused))
+#endif /* DEBUG_TOKENIZED */
+
+/* The file name is stored once per translation unit instead of one TRACE_STRING copy per call site */
+#define CREATE_MODULE_NAME(file_name) \
+    static const char trace_module_name[] TRACE_MODULE_STRING = #file_name; \
+    static const char trace_file_name[] TRACE_FILE_STRING = __FILE__; \
+    static volatile eTraceLevel_t trace_module_level = eTraceLevel_First; \
+    static const sTraceModule_t trace_module __attribute__((section(DEBUG_MODULE_SECTION), used)) = {.name = trace_module_name, .level = &trace_module_level};
+#define CREATE_MODULE_NAME_EMPTY \
+    static const char *trace_module_name __attribute__((unused)) = NULL; \
+    static const char *trace_file_name __attribute__((unused)) = NULL; \
+    static const eTraceLevel_t trace_module_level __attribute__((unused)) = eTraceLevel_Last;
 
 #if defined(ENABLE_UART_DEBUG)
-#define TRACE_INFO(format, ...) Debug_API_Print(eTraceLevel_Info, trace_module_name, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define TRACE_WRN(format, ...) Debug_API_Print(eTraceLevel_Warning, trace_module_name, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define TRACE_ERR(format, ...) Debug_API_Print(eTraceLevel_Error, trace_module_name, __FILE__, __LINE__, format, ##__VA_ARGS__)
+#define TRACE_INFO(format, ...) do { if (TRACE_IS_ENABLED(eTraceLevel_Info)) { Debug_API_Print(eTraceLevel_Info, trace_module_name, trace_file_name, __LINE__, TRACE_STRING(format), ##__VA_ARGS__); } } while (0)
+#define TRACE_WRN(format, ...) do { if (TRACE_IS_ENABLED(eTraceLevel_Warning)) { Debug_API_Print(eTraceLevel_Warning, trace_module_name, trace_file_name, __LINE__, TRACE_STRING(format), ##__VA_ARGS__); } } while (0)
+#define TRACE_ERR(format, ...) do { if (TRACE_IS_ENABLED(eTraceLevel_Error)) { Debug_API_Print(eTraceLevel_Error, trace_module_name, trace_file_name, __LINE__, TRACE_STRING(format), ##__VA_ARGS__); } } while (0)
+/* CLI feedback, always sent over DEBUG_UART, also when DEBUG_FLIGHT_RECORDER keeps the other traces in RAM */
+#define TRACE_CLI_INFO(format, ...) do { if (TRACE_IS_ENABLED(eTraceLevel_Info)) { Debug_API_PrintCli(eTraceLevel_Info, trace_module_name, trace_file_name, __LINE__, TRACE_STRING(format), ##__VA_ARGS__); } } while (0)
+#define TRACE_CLI_WRN(format, ...) do { if (TRACE_IS_ENABLED(eTraceLevel_Warning)) { Debug_API_PrintCli(eTraceLevel_Warning, trace_module_name, trace_file_name, __LINE__, TRACE_STRING(format), ##__VA_ARGS__); } } while (0)
 #else
 #define TRACE_INFO(format, ...)
 #define TRACE_WRN(format, ...)
 #define TRACE_ERR(format, ...)
+#define TRACE_CLI_INFO(format, ...)
+#define TRACE_CLI_WRN(format, ...)
 #endif /* ENABLE_UART_DEBUG */
 
+/* Begin/end markers for Tools/trace_to_chrome.py, scope must be a string literal (e.g. TRACE_SCOPE_BEGIN("cli_command")) */
+#if defined(DEBUG_TIMESTAMP)
+#define TRACE_SCOPE_BEGIN(scope) TRACE_INFO(">> " scope "\n")
+#define TRACE_SCOPE_END(scope) TRACE_INFO("<< " scope "\n")
+#else
+#define TRACE_SCOPE_BEGIN(scope)
+#define TRACE_SCOPE_END(scope)
+#endif /* DEBUG_TIMESTAMP */
+
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
@@ -43,6 +93,13 @@ typedef enum eTraceLevel {
     eTraceLevel_Last
 } eTraceLevel_t;
 
+/* clang-format off */
+typedef struct sTraceModule {
+    const char *name;
+    volatile eTraceLevel_t *level;
+} sTraceModule_t;
+/* clang-format on */
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -53,6 +110,13 @@ typedef enum eTraceLevel {
 
 bool Debug_API_Init (const eBaudrate_t baudrate);
 bool Debug_API_Print (const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, ...);
+bool Debug_API_PrintCli (const eTraceLevel_t trace_level, const char *file_trace, const char *file_name, const size_t line_number, const char *format, ...);
+bool Debug_API_GetDroppedCount (uint32_t *dropped);
+bool Debug_API_SetModuleLevel (const char *module_name, const eTraceLevel_t trace_level);
+#if defined(DEBUG_FLIGHT_RECORDER)
+bool Debug_API_DumpRecorder (void);
+bool Debug_API_ClearRecorder (void);
+#endif /* DEBUG_FLIGHT_RECORDER */
 
 #endif /* ENABLE_UART_DEBUG */
 #endif /* SOURCE_API_DEBUG_API_H_ */
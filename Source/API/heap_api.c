@@ -5,14 +5,94 @@
 #include "heap_api.h"
 
 #include "cmsis_os2.h"
+#include "rtos_api.h"
+
+#if defined(HEAP_API_POOL) || defined(HEAP_API_TLSF) || defined(HEAP_STATS)
+#include <string.h>
+#endif /* HEAP_API_POOL || HEAP_API_TLSF || HEAP_STATS */
+
+#if defined(HEAP_API_POOL)
+#include <stdatomic.h>
+#endif /* HEAP_API_POOL */
+
+#if defined(HEAP_API_TLSF)
+#include "tlsf.h"
+#endif /* HEAP_API_TLSF */
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
+#if defined(HEAP_API_POOL)
+/* Blocks are rounded up to 8 bytes so any payload, doubles included, is naturally aligned */
+#define HEAP_POOL_ALIGNMENT sizeof(uint64_t)
+#define HEAP_POOL_BLOCK_WORDS(size) (((size) + HEAP_POOL_ALIGNMENT - 1U) / HEAP_POOL_ALIGNMENT)
+
+/* The free list head packs an ABA tag in the upper half and the first free block index in the lower half */
+#define HEAP_POOL_INDEX_MASK 0xFFFFU
+#define HEAP_POOL_INDEX_NONE HEAP_POOL_INDEX_MASK
+#define HEAP_POOL_TAG_INCREMENT 0x10000UL
+
+#define HEAP_POOL_HEAD(tag_source, index) ((((tag_source) + HEAP_POOL_TAG_INCREMENT) & ~(uint32_t) HEAP_POOL_INDEX_MASK) | (index))
+
+#if defined(HEAP_POOL_1_BLOCK_SIZE)
+_Static_assert(HEAP_POOL_1_BLOCK_COUNT < HEAP_POOL_INDEX_NONE, "HEAP_POOL_1_BLOCK_COUNT must fit a 16 bit block index");
+#endif /* HEAP_POOL_1_BLOCK_SIZE */
+
+#if defined(HEAP_POOL_2_BLOCK_SIZE)
+_Static_assert(HEAP_POOL_2_BLOCK_COUNT < HEAP_POOL_INDEX_NONE, "HEAP_POOL_2_BLOCK_COUNT must fit a 16 bit block index");
+#endif /* HEAP_POOL_2_BLOCK_SIZE */
+
+#if defined(HEAP_POOL_3_BLOCK_SIZE)
+_Static_assert(HEAP_POOL_3_BLOCK_COUNT < HEAP_POOL_INDEX_NONE, "HEAP_POOL_3_BLOCK_COUNT must fit a 16 bit block index");
+#endif /* HEAP_POOL_3_BLOCK_SIZE */
+
+#if defined(HEAP_POOL_4_BLOCK_SIZE)
+_Static_assert(HEAP_POOL_4_BLOCK_COUNT < HEAP_POOL_INDEX_NONE, "HEAP_POOL_4_BLOCK_COUNT must fit a 16 bit block index");
+#endif /* HEAP_POOL_4_BLOCK_SIZE */
+#endif /* HEAP_API_POOL */
+
+#if defined(HEAP_STATS)
+#define HEAP_STATS_MAGIC 0xA110U
+#define HEAP_STATS_OTHER_SITE (HEAP_STATS_SITE_COUNT - 1U)
+#define HEAP_STATS_SMALLEST_BUCKET_LOG2 3U
+
+_Static_assert(HEAP_STATS_SITE_COUNT <= UINT16_MAX, "HEAP_STATS_SITE_COUNT must fit a 16 bit site index");
+#endif /* HEAP_STATS */
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
+
+#if defined(HEAP_API_POOL)
+/* clang-format off */
+typedef struct sHeapPoolDesc {
+    uint64_t *memory;
+    size_t block_size;
+    size_t block_count;
+} sHeapPoolDesc_t;
+
+typedef struct sHeapPoolDynamic {
+    atomic_uint_least32_t free_head;
+    atomic_size_t used;
+    atomic_size_t peak_used;
+    atomic_uint_least32_t failed;
+} sHeapPoolDynamic_t;
+/* clang-format on */
+#endif /* HEAP_API_POOL */
+
+#if defined(HEAP_STATS)
+/* clang-format off */
+/* Sits in front of every tracked block, keeps the payload 8 byte aligned */
+typedef struct sHeapStatsHeader {
+    uint32_t size;
+    uint16_t site;
+    uint16_t magic;
+} sHeapStatsHeader_t;
+/* clang-format on */
+
+_Static_assert(8U == sizeof(sHeapStatsHeader_t), "Tracked payloads must stay 8 byte aligned");
+#endif /* HEAP_STATS */
  
 /**********************************************************************************************************************
  * Private constants
@@ -31,6 +111,74 @@ static const osMutexAttr_t g_heap_mutex_attributes = {
 
 static osMutexId_t g_heap_mutex = NULL;
 
+#if defined(HEAP_API_TLSF)
+static uint64_t g_tlsf_memory[HEAP_TLSF_SIZE / sizeof(uint64_t)] = {0};
+static Tlsf_Handle g_tlsf = NULL;
+#endif /* HEAP_API_TLSF */
+
+#if defined(HEAP_STATS)
+static sHeapStats_t g_heap_stats = {0};
+static sHeapSite_t g_heap_sites[HEAP_STATS_SITE_COUNT] = {0};
+static size_t g_heap_site_count = 0;
+#endif /* HEAP_STATS */
+
+#if defined(HEAP_API_POOL)
+#if defined(HEAP_POOL_1_BLOCK_SIZE)
+static uint64_t g_pool_1_memory[HEAP_POOL_1_BLOCK_COUNT * HEAP_POOL_BLOCK_WORDS(HEAP_POOL_1_BLOCK_SIZE)] = {0};
+#endif /* HEAP_POOL_1_BLOCK_SIZE */
+
+#if defined(HEAP_POOL_2_BLOCK_SIZE)
+static uint64_t g_pool_2_memory[HEAP_POOL_2_BLOCK_COUNT * HEAP_POOL_BLOCK_WORDS(HEAP_POOL_2_BLOCK_SIZE)] = {0};
+#endif /* HEAP_POOL_2_BLOCK_SIZE */
+
+#if defined(HEAP_POOL_3_BLOCK_SIZE)
+static uint64_t g_pool_3_memory[HEAP_POOL_3_BLOCK_COUNT * HEAP_POOL_BLOCK_WORDS(HEAP_POOL_3_BLOCK_SIZE)] = {0};
+#endif /* HEAP_POOL_3_BLOCK_SIZE */
+
+#if defined(HEAP_POOL_4_BLOCK_SIZE)
+static uint64_t g_pool_4_memory[HEAP_POOL_4_BLOCK_COUNT * HEAP_POOL_BLOCK_WORDS(HEAP_POOL_4_BLOCK_SIZE)] = {0};
+#endif /* HEAP_POOL_4_BLOCK_SIZE */
+
+/* clang-format off */
+static const sHeapPoolDesc_t g_static_pool_lut[eHeapPool_Last] = {
+    #if defined(HEAP_POOL_1_BLOCK_SIZE)
+    [eHeapPool_1] = {
+        .memory = g_pool_1_memory,
+        .block_size = HEAP_POOL_BLOCK_WORDS(HEAP_POOL_1_BLOCK_SIZE) * HEAP_POOL_ALIGNMENT,
+        .block_count = HEAP_POOL_1_BLOCK_COUNT
+    },
+    #endif /* HEAP_POOL_1_BLOCK_SIZE */
+
+    #if defined(HEAP_POOL_2_BLOCK_SIZE)
+    [eHeapPool_2] = {
+        .memory = g_pool_2_memory,
+        .block_size = HEAP_POOL_BLOCK_WORDS(HEAP_POOL_2_BLOCK_SIZE) * HEAP_POOL_ALIGNMENT,
+        .block_count = HEAP_POOL_2_BLOCK_COUNT
+    },
+    #endif /* HEAP_POOL_2_BLOCK_SIZE */
+
+    #if defined(HEAP_POOL_3_BLOCK_SIZE)
+    [eHeapPool_3] = {
+        .memory = g_pool_3_memory,
+        .block_size = HEAP_POOL_BLOCK_WORDS(HEAP_POOL_3_BLOCK_SIZE) * HEAP_POOL_ALIGNMENT,
+        .block_count = HEAP_POOL_3_BLOCK_COUNT
+    },
+    #endif /* HEAP_POOL_3_BLOCK_SIZE */
+
+    #if defined(HEAP_POOL_4_BLOCK_SIZE)
+    [eHeapPool_4] = {
+        .memory = g_pool_4_memory,
+        .block_size = HEAP_POOL_BLOCK_WORDS(HEAP_POOL_4_BLOCK_SIZE) * HEAP_POOL_ALIGNMENT,
+        .block_count = HEAP_POOL_4_BLOCK_COUNT
+    },
+    #endif /* HEAP_POOL_4_BLOCK_SIZE */
+};
+/* clang-format on */
+
+static sHeapPoolDynamic_t g_dynamic_pool_lut[eHeapPool_Last] = {0};
+static bool g_is_pool_initialized = false;
+#endif /* HEAP_API_POOL */
+
 /**********************************************************************************************************************
  * Exported variables and references
  *********************************************************************************************************************/
@@ -39,60 +187,481 @@ static osMutexId_t g_heap_mutex = NULL;
  * Prototypes of private functions
  *********************************************************************************************************************/
 
+static void *Heap_API_BackendAllocate (const size_t size);
+static bool Heap_API_BackendFree (void *pointer_to_memory);
+
+#if defined(HEAP_STATS)
+static size_t Heap_API_FindSite (const char *file, const uint32_t line);
+static size_t Heap_API_GetHistogramBucket (const size_t size);
+#endif /* HEAP_STATS */
+
+#if defined(HEAP_API_POOL)
+static bool Heap_API_PoolInit (void);
+static uint8_t *Heap_API_PoolGetBlock (const eHeapPool_t pool, const uint32_t index);
+static void *Heap_API_PoolPop (const eHeapPool_t pool);
+static void Heap_API_PoolPush (const eHeapPool_t pool, const uint32_t index);
+static bool Heap_API_PoolFind (const void *pointer_to_memory, eHeapPool_t *pool, uint32_t *index);
+#endif /* HEAP_API_POOL */
+
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
+static void *Heap_API_BackendAllocate (const size_t size) {
+    if (NULL == g_heap_mutex) {
+        return NULL;
+    }
+
+    #if defined(HEAP_API_POOL)
+    /* Small payloads come from the pools without the mutex, the heap only serves what the pools cannot */
+    void *block = Heap_API_PoolAllocate(size);
+
+    if (NULL != block) {
+        return block;
+    }
+    #endif /* HEAP_API_POOL */
+    
+    if (osOK != osMutexAcquire(g_heap_mutex, HEAP_API_MUTEX_TIMEOUT)) {
+        return NULL;
+    }
+
+    void *allocated_memory = NULL;
+
+    #if defined(HEAP_API_TLSF)
+    allocated_memory = Tlsf_Allocate(g_tlsf, size);
+
+    if (NULL != allocated_memory) {
+        memset(allocated_memory, 0, size);
+    }
+    #else
+    allocated_memory = calloc(1, size);
+    #endif /* HEAP_API_TLSF */
+
+    osMutexRelease(g_heap_mutex);
+
+    return allocated_memory;
+}
+
+static bool Heap_API_BackendFree (void *pointer_to_memory) {
+    if (NULL == pointer_to_memory) {
+        return false;
+    }
+
+    #if defined(HEAP_API_POOL)
+    if (Heap_API_PoolFree(pointer_to_memory)) {
+        return true;
+    }
+    #endif /* HEAP_API_POOL */
+    
+    if (osOK != osMutexAcquire(g_heap_mutex, HEAP_API_MUTEX_TIMEOUT)) {
+        return false;
+    }
+
+    #if defined(HEAP_API_TLSF)
+    bool is_freed = Tlsf_Free(g_tlsf, pointer_to_memory);
+    #else
+    bool is_freed = true;
+
+    free(pointer_to_memory);
+    #endif /* HEAP_API_TLSF */
+
+    osMutexRelease(g_heap_mutex);
+
+    return is_freed;
+}
+
+#if defined(HEAP_STATS)
+/* Called with the heap mutex held, a site is matched by line first so most lookups skip the string compare */
+static size_t Heap_API_FindSite (const char *file, const uint32_t line) {
+    if (NULL == file) {
+        return HEAP_STATS_OTHER_SITE;
+    }
+
+    for (size_t site = 0; site < g_heap_site_count; site++) {
+        if ((line == g_heap_sites[site].line) && ((file == g_heap_sites[site].file) || (0 == strcmp(file, g_heap_sites[site].file)))) {
+            return site;
+        }
+    }
+
+    if (g_heap_site_count >= HEAP_STATS_OTHER_SITE) {
+        return HEAP_STATS_OTHER_SITE;
+    }
+
+    g_heap_sites[g_heap_site_count].file = file;
+    g_heap_sites[g_heap_site_count].line = line;
+    g_heap_site_count++;
+
+    return g_heap_site_count - 1;
+}
+
+/* Bucket 0 counts sizes up to 8 bytes, every following bucket doubles the limit, the last one takes the rest */
+static size_t Heap_API_GetHistogramBucket (const size_t size) {
+    size_t bucket = 0;
+
+    while (((size_t) 1U << (bucket + HEAP_STATS_SMALLEST_BUCKET_LOG2)) < size) {
+        bucket++;
+
+        if ((HEAP_STATS_HISTOGRAM_SIZE - 1U) == bucket) {
+            break;
+        }
+    }
+
+    return bucket;
+}
+#endif /* HEAP_STATS */
+
+#if defined(HEAP_API_POOL)
+/* Threads every block onto its pool's free list, pools must be listed in ascending block size */
+static bool Heap_API_PoolInit (void) {
+    for (eHeapPool_t pool = eHeapPool_First; pool < eHeapPool_Last; pool++) {
+        if ((pool > eHeapPool_First) && (g_static_pool_lut[pool].block_size < g_static_pool_lut[pool - 1].block_size)) {
+            return false;
+        }
+
+        for (uint32_t index = 0; index < g_static_pool_lut[pool].block_count; index++) {
+            uint16_t next = ((index + 1) < g_static_pool_lut[pool].block_count) ? (uint16_t) (index + 1) : HEAP_POOL_INDEX_NONE;
+
+            memcpy(Heap_API_PoolGetBlock(pool, index), &next, sizeof(next));
+        }
+
+        atomic_init(&g_dynamic_pool_lut[pool].free_head, (0 == g_static_pool_lut[pool].block_count) ? HEAP_POOL_INDEX_NONE : 0);
+        atomic_init(&g_dynamic_pool_lut[pool].used, 0);
+        atomic_init(&g_dynamic_pool_lut[pool].peak_used, 0);
+        atomic_init(&g_dynamic_pool_lut[pool].failed, 0);
+    }
+
+    return true;
+}
+
+static uint8_t *Heap_API_PoolGetBlock (const eHeapPool_t pool, const uint32_t index) {
+    return (uint8_t *) g_static_pool_lut[pool].memory + (index * g_static_pool_lut[pool].block_size);
+}
+
+/* Treiber stack pop, the tag changes on every update so a block freed and reused meanwhile fails the CAS */
+static void *Heap_API_PoolPop (const eHeapPool_t pool) {
+    sHeapPoolDynamic_t *dynamic = &g_dynamic_pool_lut[pool];
+    uint32_t head = atomic_load_explicit(&dynamic->free_head, memory_order_acquire);
+    uint8_t *block = NULL;
+
+    do {
+        uint32_t index = head & HEAP_POOL_INDEX_MASK;
+
+        if (HEAP_POOL_INDEX_NONE == index) {
+            return NULL;
+        }
+
+        block = Heap_API_PoolGetBlock(pool, index);
+
+        uint16_t next = *(volatile uint16_t *) block;
+
+        if (atomic_compare_exchange_weak_explicit(&dynamic->free_head, &head, HEAP_POOL_HEAD(head, next), memory_order_acq_rel, memory_order_acquire)) {
+            break;
+        }
+    } while (true);
+
+    size_t used = atomic_fetch_add_explicit(&dynamic->used, 1, memory_order_relaxed) + 1;
+    size_t peak_used = atomic_load_explicit(&dynamic->peak_used, memory_order_relaxed);
+
+    while ((used > peak_used) && !atomic_compare_exchange_weak_explicit(&dynamic->peak_used, &peak_used, used, memory_order_relaxed, memory_order_relaxed)) {}
+
+    return block;
+}
+
+static void Heap_API_PoolPush (const eHeapPool_t pool, const uint32_t index) {
+    sHeapPoolDynamic_t *dynamic = &g_dynamic_pool_lut[pool];
+    uint8_t *block = Heap_API_PoolGetBlock(pool, index);
+    uint32_t head = atomic_load_explicit(&dynamic->free_head, memory_order_relaxed);
+
+    do {
+        *(volatile uint16_t *) block = (uint16_t) (head & HEAP_POOL_INDEX_MASK);
+    } while (!atomic_compare_exchange_weak_explicit(&dynamic->free_head, &head, HEAP_POOL_HEAD(head, index), memory_order_release, memory_order_relaxed));
+
+    atomic_fetch_sub_explicit(&dynamic->used, 1, memory_order_relaxed);
+
+    return;
+}
+
+/* Matches a pointer to its pool by address range, only the start of a block is accepted */
+static bool Heap_API_PoolFind (const void *pointer_to_memory, eHeapPool_t *pool, uint32_t *index) {
+    for (eHeapPool_t candidate = eHeapPool_First; candidate < eHeapPool_Last; candidate++) {
+        const uint8_t *start = (const uint8_t *) g_static_pool_lut[candidate].memory;
+        size_t pool_size = g_static_pool_lut[candidate].block_size * g_static_pool_lut[candidate].block_count;
+
+        if (((const uint8_t *) pointer_to_memory < start) || ((const uint8_t *) pointer_to_memory >= (start + pool_size))) {
+            continue;
+        }
+
+        size_t offset = (size_t) ((const uint8_t *) pointer_to_memory - start);
+
+        if (0 != (offset % g_static_pool_lut[candidate].block_size)) {
+            return false;
+        }
+
+        *pool = candidate;
+        *index = (uint32_t) (offset / g_static_pool_lut[candidate].block_size);
+
+        return true;
+    }
+
+    return false;
+}
+#endif /* HEAP_API_POOL */
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
 
 bool Heap_API_Init (void) {
     if (NULL == g_heap_mutex) {
-        g_heap_mutex = osMutexNew(&g_heap_mutex_attributes);
+        g_heap_mutex = RTOS_API_MutexNew(&g_heap_mutex_attributes);
     }
 
     if (NULL == g_heap_mutex) {
         return false;
     }
 
+    #if defined(HEAP_API_TLSF)
+    if (NULL == g_tlsf) {
+        g_tlsf = Tlsf_Init(g_tlsf_memory, sizeof(g_tlsf_memory));
+    }
+
+    if (NULL == g_tlsf) {
+        return false;
+    }
+    #endif /* HEAP_API_TLSF */
+
+    #if defined(HEAP_API_POOL)
+    if (!g_is_pool_initialized) {
+        g_is_pool_initialized = Heap_API_PoolInit();
+    }
+
+    if (!g_is_pool_initialized) {
+        return false;
+    }
+    #endif /* HEAP_API_POOL */
+
     return true;
 }
 
-void *Heap_API_MemoryAllocate(const size_t number_of_elements, const size_t size) {
+void *Heap_API_MemoryAllocate (const size_t number_of_elements, const size_t size) {
+    #if defined(HEAP_STATS)
+    return Heap_API_TrackedAllocate(number_of_elements, size, NULL, 0);
+    #else
     if ((0 == number_of_elements) || (0 == size)) {
         return NULL;
     }
 
+    if (number_of_elements > (SIZE_MAX / size)) {
+        return NULL;
+    }
+
+    return Heap_API_BackendAllocate(number_of_elements * size);
+    #endif /* HEAP_STATS */
+}
+
+bool Heap_API_Free (void *pointer_to_memory) {
+    if (NULL == pointer_to_memory) {
+        return false;
+    }
+
+    #if defined(HEAP_STATS)
+    #if defined(HEAP_API_POOL)
+    eHeapPool_t pool = eHeapPool_Last;
+    uint32_t index = 0;
+
+    /* Blocks from Heap_API_PoolAllocate carry no header and start on a pool block, a tracked payload starts 8 bytes
+     * into its block and pool blocks are multiples of 8 bytes, so a pool block start is never a tracked payload */
+    if (g_is_pool_initialized && Heap_API_PoolFind(pointer_to_memory, &pool, &index)) {
+        return Heap_API_PoolFree(pointer_to_memory);
+    }
+    #endif /* HEAP_API_POOL */
+
+    /* Everything else was allocated through Heap_API_TrackedAllocate, a cleared magic means a double free */
+    sHeapStatsHeader_t *header = (sHeapStatsHeader_t *) pointer_to_memory - 1;
+
+    if (HEAP_STATS_MAGIC != header->magic) {
+        return false;
+    }
+
+    if (osOK != osMutexAcquire(g_heap_mutex, HEAP_API_MUTEX_TIMEOUT)) {
+        return false;
+    }
+
+    g_heap_stats.current_bytes -= header->size;
+    g_heap_stats.frees++;
+    g_heap_sites[header->site].outstanding_bytes -= header->size;
+    g_heap_sites[header->site].outstanding_count--;
+    header->magic = 0;
+
+    osMutexRelease(g_heap_mutex);
+
+    return Heap_API_BackendFree(header);
+    #else
+    return Heap_API_BackendFree(pointer_to_memory);
+    #endif /* HEAP_STATS */
+}
+
+#if defined(HEAP_STATS)
+/* Prepends a header naming the call site, Heap_API_Malloc and Heap_API_Calloc pass __FILE__ and __LINE__ */
+void *Heap_API_TrackedAllocate (const size_t number_of_elements, const size_t size, const char *file, const uint32_t line) {
+    if ((0 == number_of_elements) || (0 == size)) {
+        return NULL;
+    }
+
+    if ((number_of_elements > (SIZE_MAX / size)) || ((number_of_elements * size) > (UINT32_MAX - sizeof(sHeapStatsHeader_t)))) {
+        return NULL;
+    }
+
     if (NULL == g_heap_mutex) {
         return NULL;
     }
-    
+
+    size_t requested_size = number_of_elements * size;
+    sHeapStatsHeader_t *header = Heap_API_BackendAllocate(sizeof(sHeapStatsHeader_t) + requested_size);
+
     if (osOK != osMutexAcquire(g_heap_mutex, HEAP_API_MUTEX_TIMEOUT)) {
+        Heap_API_BackendFree(header);
+
         return NULL;
     }
 
-    void *allocated_memory = NULL;
+    if (NULL == header) {
+        g_heap_stats.failed++;
+
+        osMutexRelease(g_heap_mutex);
+
+        return NULL;
+    }
 
-    allocated_memory = calloc(number_of_elements, size);
+    size_t site = Heap_API_FindSite(file, line);
+
+    header->size = (uint32_t) requested_size;
+    header->site = (uint16_t) site;
+    header->magic = HEAP_STATS_MAGIC;
+
+    g_heap_stats.current_bytes += requested_size;
+    g_heap_stats.allocations++;
+    g_heap_stats.histogram[Heap_API_GetHistogramBucket(requested_size)]++;
+
+    if (g_heap_stats.current_bytes > g_heap_stats.peak_bytes) {
+        g_heap_stats.peak_bytes = g_heap_stats.current_bytes;
+    }
+
+    g_heap_sites[site].outstanding_bytes += requested_size;
+    g_heap_sites[site].outstanding_count++;
 
     osMutexRelease(g_heap_mutex);
 
-    return allocated_memory;
+    return header + 1;
 }
 
-bool Heap_API_Free (void *pointer_to_memory) {
-    if (NULL == pointer_to_memory) {
+bool Heap_API_GetStats (sHeapStats_t *stats) {
+    if (NULL == stats) {
         return false;
     }
-    
+
+    if (NULL == g_heap_mutex) {
+        return false;
+    }
+
     if (osOK != osMutexAcquire(g_heap_mutex, HEAP_API_MUTEX_TIMEOUT)) {
         return false;
     }
 
-    free(pointer_to_memory);
+    *stats = g_heap_stats;
 
     osMutexRelease(g_heap_mutex);
 
     return true;
 }
+
+/* Sites are filled in order of first allocation, the last entry has a NULL file and collects untracked calls and
+ * sites that did not fit the table */
+bool Heap_API_GetSite (const size_t index, sHeapSite_t *site) {
+    if ((index >= HEAP_STATS_SITE_COUNT) || (NULL == site)) {
+        return false;
+    }
+
+    if (NULL == g_heap_mutex) {
+        return false;
+    }
+
+    if (osOK != osMutexAcquire(g_heap_mutex, HEAP_API_MUTEX_TIMEOUT)) {
+        return false;
+    }
+
+    *site = g_heap_sites[index];
+
+    osMutexRelease(g_heap_mutex);
+
+    return true;
+}
+#endif /* HEAP_STATS */
+
+#if defined(HEAP_API_POOL)
+/* O(1) and lock-free so it may be called from interrupts, takes the smallest pool with a free block that fits */
+void *Heap_API_PoolAllocate (const size_t size) {
+    if ((0 == size) || !g_is_pool_initialized) {
+        return NULL;
+    }
+
+    bool is_failure_counted = false;
+
+    for (eHeapPool_t pool = eHeapPool_First; pool < eHeapPool_Last; pool++) {
+        if (size > g_static_pool_lut[pool].block_size) {
+            continue;
+        }
+
+        void *block = Heap_API_PoolPop(pool);
+
+        if (NULL != block) {
+            memset(block, 0, size);
+
+            return block;
+        }
+
+        if (!is_failure_counted) {
+            atomic_fetch_add_explicit(&g_dynamic_pool_lut[pool].failed, 1, memory_order_relaxed);
+            is_failure_counted = true;
+        }
+    }
+
+    return NULL;
+}
+
+/* Returns false for pointers that do not belong to a pool */
+bool Heap_API_PoolFree (void *pointer_to_memory) {
+    if ((NULL == pointer_to_memory) || !g_is_pool_initialized) {
+        return false;
+    }
+
+    eHeapPool_t pool = eHeapPool_Last;
+    uint32_t index = 0;
+
+    if (!Heap_API_PoolFind(pointer_to_memory, &pool, &index)) {
+        return false;
+    }
+
+    Heap_API_PoolPush(pool, index);
+
+    return true;
+}
+
+bool Heap_API_PoolGetStats (const eHeapPool_t pool, sHeapPoolStats_t *stats) {
+    if ((pool <= eHeapPool_First) || (pool >= eHeapPool_Last)) {
+        return false;
+    }
+
+    if (NULL == stats) {
+        return false;
+    }
+
+    stats->block_size = g_static_pool_lut[pool].block_size;
+    stats->block_count = g_static_pool_lut[pool].block_count;
+    stats->used = atomic_load_explicit(&g_dynamic_pool_lut[pool].used, memory_order_relaxed);
+    stats->peak_used = atomic_load_explicit(&g_dynamic_pool_lut[pool].peak_used, memory_order_relaxed);
+    stats->failed = atomic_load_explicit(&g_dynamic_pool_lut[pool].failed, memory_order_relaxed);
+
+    return true;
+}
+#endif /* HEAP_API_POOL */
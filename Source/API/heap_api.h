@@ -14,13 +14,83 @@
  * Exported definitions and macros
  *********************************************************************************************************************/
 
+#if defined(HEAP_STATS)
+#define Heap_API_Malloc(size) Heap_API_TrackedAllocate(1, size, __FILE__, __LINE__)
+#define Heap_API_Calloc(number_of_elements, size) Heap_API_TrackedAllocate(number_of_elements, size, __FILE__, __LINE__)
+
+/* Size histogram buckets, up to 8, 16, ... bytes with the last one counting everything larger */
+#define HEAP_STATS_HISTOGRAM_SIZE 8U
+#else
 #define Heap_API_Malloc(size) Heap_API_MemoryAllocate(1, size)
 #define Heap_API_Calloc(number_of_elements, size) Heap_API_MemoryAllocate(number_of_elements, size)
+#endif /* HEAP_STATS */
+
+#if defined(HEAP_POOL_1_BLOCK_SIZE) || defined(HEAP_POOL_2_BLOCK_SIZE) || defined(HEAP_POOL_3_BLOCK_SIZE) || defined(HEAP_POOL_4_BLOCK_SIZE)
+#define HEAP_API_POOL
+#endif /* HEAP_POOL_x_BLOCK_SIZE */
+
+#if defined(HEAP_TLSF_SIZE)
+#define HEAP_API_TLSF
+#endif /* HEAP_TLSF_SIZE */
 
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
 
+#if defined(HEAP_API_POOL)
+/* clang-format off */
+typedef enum eHeapPool {
+    eHeapPool_First = 0,
+
+    #if defined(HEAP_POOL_1_BLOCK_SIZE)
+    eHeapPool_1,
+    #endif /* HEAP_POOL_1_BLOCK_SIZE */
+
+    #if defined(HEAP_POOL_2_BLOCK_SIZE)
+    eHeapPool_2,
+    #endif /* HEAP_POOL_2_BLOCK_SIZE */
+
+    #if defined(HEAP_POOL_3_BLOCK_SIZE)
+    eHeapPool_3,
+    #endif /* HEAP_POOL_3_BLOCK_SIZE */
+
+    #if defined(HEAP_POOL_4_BLOCK_SIZE)
+    eHeapPool_4,
+    #endif /* HEAP_POOL_4_BLOCK_SIZE */
+
+    eHeapPool_Last
+} eHeapPool_t;
+
+typedef struct sHeapPoolStats {
+    size_t block_size;
+    size_t block_count;
+    size_t used;
+    size_t peak_used;
+    uint32_t failed;
+} sHeapPoolStats_t;
+/* clang-format on */
+#endif /* HEAP_API_POOL */
+
+#if defined(HEAP_STATS)
+/* clang-format off */
+typedef struct sHeapStats {
+    size_t current_bytes;
+    size_t peak_bytes;
+    uint32_t allocations;
+    uint32_t frees;
+    uint32_t failed;
+    uint32_t histogram[HEAP_STATS_HISTOGRAM_SIZE];
+} sHeapStats_t;
+
+typedef struct sHeapSite {
+    const char *file;
+    uint32_t line;
+    size_t outstanding_bytes;
+    uint32_t outstanding_count;
+} sHeapSite_t;
+/* clang-format on */
+#endif /* HEAP_STATS */
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -33,4 +103,16 @@ bool Heap_API_Init (void);
 void *Heap_API_MemoryAllocate (const size_t number_of_elements, const size_t size);
 bool Heap_API_Free (void *pointer_to_memory);
 
+#if defined(HEAP_API_POOL)
+void *Heap_API_PoolAllocate (const size_t size);
+bool Heap_API_PoolFree (void *pointer_to_memory);
+bool Heap_API_PoolGetStats (const eHeapPool_t pool, sHeapPoolStats_t *stats);
+#endif /* HEAP_API_POOL */
+
+#if defined(HEAP_STATS)
+void *Heap_API_TrackedAllocate (const size_t number_of_elements, const size_t size, const char *file, const uint32_t line);
+bool Heap_API_GetStats (sHeapStats_t *stats);
+bool Heap_API_GetSite (const size_t index, sHeapSite_t *site);
+#endif /* HEAP_STATS */
+
 #endif /* SOURCE_API_HEAP_API_H_ */
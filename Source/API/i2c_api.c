@@ -6,6 +6,7 @@
 
 #if defined(ENABLE_I2C)
 #include "cmsis_os2.h"
+#include "rtos_api.h"
 #include "debug_api.h"
 #include "i2c_driver.h"
 #include "gpio_driver.h"
@@ -440,13 +441,13 @@ bool I2C_API_Init (const eI2c_t i2c) {
 
     g_static_i2c_lut[i2c] = *desc;
 
-    g_dynamic_i2c[i2c].flag = osEventFlagsNew(&g_static_i2c_lut[i2c].flag_attributes);
+    g_dynamic_i2c[i2c].flag = RTOS_API_EventFlagsNew(&g_static_i2c_lut[i2c].flag_attributes);
     
     if (NULL == g_dynamic_i2c[i2c].flag) {
         return false;
     }
 
-    g_dynamic_i2c[i2c].mutex = osMutexNew(&g_static_i2c_lut[i2c].mutex_attributes);
+    g_dynamic_i2c[i2c].mutex = RTOS_API_MutexNew(&g_static_i2c_lut[i2c].mutex_attributes);
 
     if (NULL == g_dynamic_i2c[i2c].mutex) {
         return false;
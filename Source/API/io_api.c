@@ -9,13 +9,21 @@
 #include "debug_api.h"
 #include "exti_driver.h"
 #include "gpio_driver.h"
+#include "rtos_api.h"
+#include "typed_ring_buffer.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
 #define MUTEX_TIMEOUT 0U
-#define IO_MESSAGE_WAKEUP
+#define IO_EVENT_FLAG 0x01U
+#define IO_EVENT_RING_CAPACITY 16U
+
+/* EXTI devices stay masked until debounce ends, so at most one pending event per device */
+_Static_assert(eIo_Last <= IO_EVENT_RING_CAPACITY, "IO_EVENT_RING_CAPACITY must hold one event per IO device");
+
+TYPED_RING_BUFFER_DEFINE(IO_API_EventRing, eIo_t, IO_EVENT_RING_CAPACITY)
 
 /**********************************************************************************************************************
  * Private typedef
@@ -61,7 +69,7 @@ CREATE_MODULE_NAME_EMPTY
  *********************************************************************************************************************/
 
 static osThreadId_t g_io_thread_id = NULL;
-static osMessageQueueId_t g_io_message_queue_id = NULL;
+static IO_API_EventRing_t g_io_event_ring = {0};
 
 static bool g_has_polled_io = false;
 static eIoState_t g_io_state = eIoState_Default;
@@ -90,9 +98,13 @@ static void IO_API_Thread (void *arg) {
     eIo_t device;
     
     while (1) {
-        if (osOK == osMessageQueueGet(g_io_message_queue_id, &device, IO_MESSAGE_QUEUE_PRIORITY, g_has_polled_io ? osWaitForever : IO_MESSAGE_QUEUE_TIMEOUT)) {    
-            if (g_static_io_desc_lut[device].is_debounce_enable) {
-                IO_API_StartDebounceTimer(device);
+        uint32_t flags = osThreadFlagsWait(IO_EVENT_FLAG, osFlagsWaitAny, g_has_polled_io ? osWaitForever : IO_MESSAGE_QUEUE_TIMEOUT);
+
+        if (0 == (flags & osFlagsError)) {
+            while (IO_API_EventRing_Pop(&g_io_event_ring, &device)) {
+                if (g_static_io_desc_lut[device].is_debounce_enable) {
+                    IO_API_StartDebounceTimer(device);
+                }
             }
 
             continue;
@@ -138,7 +150,10 @@ static void IO_API_ExtiTriggered (void *context) {
     }
 
     Exti_Driver_DisableIt(g_static_io_desc_lut[device->device].exti_device);
-    osMessageQueuePut(g_io_message_queue_id, &device->device, IO_MESSAGE_QUEUE_PRIORITY, 0);
+
+    if (IO_API_EventRing_Push(&g_io_event_ring, &device->device)) {
+        osThreadFlagsSet(g_io_thread_id, IO_EVENT_FLAG);
+    }
 
     return;
 }
@@ -282,7 +297,7 @@ bool IO_API_Init (const eIo_t device, osEventFlagsId_t event_flags_id) {
     }
 
     if (g_static_io_desc_lut[device].is_debounce_enable) {
-        g_dynamic_io_lut[device].debounce_timer = osTimerNew(IO_API_DebounceTimerCallback, osTimerOnce, &g_dynamic_io_lut[device], &g_static_io_desc_lut[device].debounce_timer_attributes);
+        g_dynamic_io_lut[device].debounce_timer = RTOS_API_TimerNew(IO_API_DebounceTimerCallback, osTimerOnce, &g_dynamic_io_lut[device], &g_static_io_desc_lut[device].debounce_timer_attributes);
     
         if (NULL == g_dynamic_io_lut[device].debounce_timer) {
             return false;
@@ -290,7 +305,7 @@ bool IO_API_Init (const eIo_t device, osEventFlagsId_t event_flags_id) {
     }
 
     if (NULL == g_dynamic_io_lut[device].mutex) {
-        g_dynamic_io_lut[device].mutex = osMutexNew(&g_static_io_desc_lut[device].mutex_attributes);
+        g_dynamic_io_lut[device].mutex = RTOS_API_MutexNew(&g_static_io_desc_lut[device].mutex_attributes);
     
         if (NULL == g_dynamic_io_lut[device].mutex) {
             return false;
@@ -322,21 +337,15 @@ bool IO_API_Start (void) {
         return true;
     }
 
+    IO_API_EventRing_Reset(&g_io_event_ring);
+
     if (NULL == g_io_thread_id) {
-        g_io_thread_id = osThreadNew(IO_API_Thread, NULL, &g_io_thread_attributes);
+        g_io_thread_id = RTOS_API_ThreadNew(IO_API_Thread, NULL, &g_io_thread_attributes);
 
         if (NULL == g_io_thread_id) {
             return false;
         }
     }
-    
-    if (NULL == g_io_message_queue_id) {
-        g_io_message_queue_id = osMessageQueueNew(IO_MESSAGE_CAPACITY, sizeof(eIo_t), &g_io_message_queue_attributes);
-    
-        if (NULL == g_io_message_queue_id) {
-            return false;
-        }
-    }
 
     for (eIo_t device = eIo_First; device < eIo_Last; device++) {
         if (g_static_io_desc_lut[device].is_exti) {
@@ -363,9 +372,6 @@ bool IO_API_Stop (void) {
     osThreadTerminate(g_io_thread_id);
     g_io_thread_id = NULL;
 
-    osMessageQueueDelete(g_io_message_queue_id);
-    g_io_message_queue_id = NULL;
-
     for (eIo_t device = eIo_First; device < eIo_Last; device++) {
         if (g_static_io_desc_lut[device].is_exti) {
             Exti_Driver_DisableIt(g_static_io_desc_lut[device].exti_device);
@@ -6,6 +6,7 @@
 
 #if defined(ENABLE_LED) || defined(ENABLE_PWM_LED)
 #include "cmsis_os2.h"
+#include "rtos_api.h"
 #include "debug_api.h"
 #include "gpio_driver.h"
 #include "pwm_driver.h"
@@ -226,7 +227,7 @@ bool LED_API_Init (void) {
 
         g_led_desc_lut[led] = *desc;
         
-        g_led_blink_lut[led].blink_timer = osTimerNew(LED_API_BlinkTimerCallback, osTimerPeriodic, &g_led_blink_lut[led], &g_led_desc_lut[led].blink_timer_attributes);
+        g_led_blink_lut[led].blink_timer = RTOS_API_TimerNew(LED_API_BlinkTimerCallback, osTimerPeriodic, &g_led_blink_lut[led], &g_led_desc_lut[led].blink_timer_attributes);
         
         if (NULL == g_led_blink_lut[led].blink_timer) {
             TRACE_ERR("Init: Failed to create blink timer for LED [%d]\n", led);
@@ -236,7 +237,7 @@ bool LED_API_Init (void) {
             return false;
         }
 
-        g_led_blink_lut[led].blink_mutex = osMutexNew(&g_led_desc_lut[led].blink_mutex_attributes);
+        g_led_blink_lut[led].blink_mutex = RTOS_API_MutexNew(&g_led_desc_lut[led].blink_mutex_attributes);
 
         if (NULL == g_led_blink_lut[led].blink_mutex) {
             TRACE_ERR("Init: Failed to create blink mutex for LED [%d]\n", led);
@@ -264,7 +265,7 @@ bool LED_API_Init (void) {
 
         g_pwm_led_desc_lut[led] = *desc;
 
-        g_led_pulse_lut[led].pulse_timer = osTimerNew(LED_API_PulseTimerCallback, osTimerPeriodic, &g_led_pulse_lut[led], &g_pwm_led_desc_lut[led].pulse_timer_attributes);
+        g_led_pulse_lut[led].pulse_timer = RTOS_API_TimerNew(LED_API_PulseTimerCallback, osTimerPeriodic, &g_led_pulse_lut[led], &g_pwm_led_desc_lut[led].pulse_timer_attributes);
         
         if (NULL == g_led_pulse_lut[led].pulse_timer) {
             TRACE_ERR("Init: Failed to create pulse timer for PWM LED [%d]\n", led);
@@ -274,7 +275,7 @@ bool LED_API_Init (void) {
             return false;
         }
 
-        g_led_pulse_lut[led].pulse_mutex = osMutexNew(&g_pwm_led_desc_lut[led].pulse_mutex_attributes);
+        g_led_pulse_lut[led].pulse_mutex = RTOS_API_MutexNew(&g_pwm_led_desc_lut[led].pulse_mutex_attributes);
 
         if (NULL == g_led_pulse_lut[led].pulse_mutex) {
             TRACE_ERR("Init: Failed to create pulse mutex for PWM LED [%d]\n", led);
@@ -8,12 +8,12 @@
 #include <stdint.h>
 #include <math.h>
 #include "cmsis_os2.h"
+#include "rtos_api.h"
 #include "debug_api.h"
 #include "motor_driver.h"
 #include "pwm_driver.h"
 #include "timer_driver.h"
 #include "gpio_driver.h"
-#include "float_parts.h"
 
 #if defined(ENABLE_PID_CONTROL)
 #include <stdlib.h>
@@ -100,7 +100,7 @@ static uint16_t Motor_API_ScaleSpeed (const eMotor_t motor, const float speed) {
     }
 
     if (!Motor_API_IsCorrectSpeed(speed)) {
-        TRACE_ERR("Motor_API_ScaleSpeed: Incorrect speed [%ld.%03u]\n", FLOAT_INTEGER_PART(speed), FLOAT_FRACTIONAL_PART(speed, 3));
+        TRACE_ERR("Motor_API_ScaleSpeed: Incorrect speed [%.3f]\n", speed);
         
         return 0;
     }
@@ -280,7 +280,7 @@ bool Motor_API_Init (void) {
 
         g_static_motor_lut[motor] = *desc;
         
-        g_dynamic_motor_lut[motor].mutex = osMutexNew(&g_static_motor_lut[motor].mutex_attributes);
+        g_dynamic_motor_lut[motor].mutex = RTOS_API_MutexNew(&g_static_motor_lut[motor].mutex_attributes);
 
         if (NULL == g_dynamic_motor_lut[motor].mutex) {
             TRACE_ERR("Init: Failed to create mutex for motor [%d]\n", motor);
@@ -290,7 +290,7 @@ bool Motor_API_Init (void) {
             continue;
         }
 
-        g_dynamic_motor_lut[motor].timer = osTimerNew(Motor_API_TimerCallback, osTimerPeriodic, &g_dynamic_motor_lut[motor], &g_static_motor_lut[motor].timer_attributes);
+        g_dynamic_motor_lut[motor].timer = RTOS_API_TimerNew(Motor_API_TimerCallback, osTimerPeriodic, &g_dynamic_motor_lut[motor], &g_static_motor_lut[motor].timer_attributes);
 
         if (NULL == g_dynamic_motor_lut[motor].timer) {
             TRACE_ERR("Init: Failed to create soft start timer for motor [%d]\n", motor);
@@ -309,7 +309,7 @@ bool Motor_API_Init (void) {
         }
 
         #if defined(ENABLE_PID_CONTROL)
-        g_dynamic_motor_lut[motor].control_timer = osTimerNew(Motor_API_ControlTimerCallback, osTimerPeriodic, &g_dynamic_motor_lut[motor], &g_static_motor_lut[motor].timer_attributes);
+        g_dynamic_motor_lut[motor].control_timer = RTOS_API_TimerNew(Motor_API_ControlTimerCallback, osTimerPeriodic, &g_dynamic_motor_lut[motor], &g_static_motor_lut[motor].timer_attributes);
 
         if (NULL == g_dynamic_motor_lut[motor].control_timer) {
             TRACE_ERR("Init: Failed to create control timer for motor [%d]\n", motor);
@@ -349,7 +349,7 @@ bool Motor_API_Init (void) {
 
 bool Motor_API_SetMotors (const float speed, const eMotorDirection_t direction, const eMotorControl_t control) {
     if (!Motor_API_IsCorrectSpeed(speed)) {
-        TRACE_ERR("SetMotors: Incorrect speed [%ld.%03u]\n", FLOAT_INTEGER_PART(speed), FLOAT_FRACTIONAL_PART(speed, 3));
+        TRACE_ERR("SetMotors: Incorrect speed [%.3f]\n", speed);
         
         return false;
     }
@@ -382,7 +382,7 @@ bool Motor_API_SetMotors (const float speed, const eMotorDirection_t direction,
                     if (target_speed > SOFT_TURN_SPEED_OFFSET) {
                         target_speed -= SOFT_TURN_SPEED_OFFSET;
                     } else {
-                        TRACE_WRN("SetMotors: Speed [%ld.%03u] for soft turn too small for motor [%d]\n", FLOAT_INTEGER_PART(target_speed), FLOAT_FRACTIONAL_PART(target_speed, 2), motor);
+                        TRACE_WRN("SetMotors: Speed [%.2f] for soft turn too small for motor [%d]\n", target_speed, motor);
                         target_speed = STOP_SPEED;
                     }
                 }
@@ -397,14 +397,14 @@ bool Motor_API_SetMotors (const float speed, const eMotorDirection_t direction,
                     if (target_speed > SOFT_TURN_SPEED_OFFSET) {
                         target_speed -= SOFT_TURN_SPEED_OFFSET;
                     } else {
-                        TRACE_WRN("SetMotors: Speed [%ld.%03u] for soft turn too small for motor [%d]\n", FLOAT_INTEGER_PART(target_speed), FLOAT_FRACTIONAL_PART(target_speed, 2), motor);
+                        TRACE_WRN("SetMotors: Speed [%.2f] for soft turn too small for motor [%d]\n", target_speed, motor);
                         target_speed = STOP_SPEED;
                     }
                 }
             } break;
             case eMotorDirection_Stop: {
                 if (STOP_SPEED != target_speed) {
-                    TRACE_WRN("SetMotors: Speed [%ld.%03u] for stop command, setting to 0 for motor [%d]\n", FLOAT_INTEGER_PART(target_speed), FLOAT_FRACTIONAL_PART(target_speed, 2), motor);
+                    TRACE_WRN("SetMotors: Speed [%.2f] for stop command, setting to 0 for motor [%d]\n", target_speed, motor);
 
                     target_speed = STOP_SPEED;
                 }
@@ -431,7 +431,7 @@ bool Motor_API_SetMotorSpeed (const eMotor_t motor, const float speed, const eMo
     }
 
     if (!Motor_API_IsCorrectSpeed(speed)) {
-        TRACE_ERR("SetMotorSpeed: Incorrect speed [%ld.%03u]\n", FLOAT_INTEGER_PART(speed), FLOAT_FRACTIONAL_PART(speed, 3));
+        TRACE_ERR("SetMotorSpeed: Incorrect speed [%.3f]\n", speed);
         
         return false;
     }
@@ -471,7 +471,7 @@ bool Motor_API_SetMotorSpeed (const eMotor_t motor, const float speed, const eMo
     }
 
     if (((eMotorDirection_Brake == direction) || (eMotorDirection_Stop == direction)) && (STOP_SPEED != speed)) {
-        TRACE_ERR("SetMotorSpeed: Speed [%ld.%03u] != 0, for motor [%d] brake/stop command\n", FLOAT_INTEGER_PART(speed), FLOAT_FRACTIONAL_PART(speed, 2), motor);
+        TRACE_ERR("SetMotorSpeed: Speed [%.2f] != 0, for motor [%d] brake/stop command\n", speed, motor);
 
         return false;
     }
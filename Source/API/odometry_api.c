@@ -8,6 +8,7 @@
 #include <math.h>
 #include "debug_api.h"
 #include "motor_api.h"
+#include "rtos_api.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -194,13 +195,13 @@ bool Odometry_API_Init (osEventFlagsId_t *event_flags_id) {
         g_static_encoder_lut[encoder] = *encoder_desc;
     }
 
-    g_odometry_timer_id = osTimerNew(Odometry_API_TimerCallback, osTimerPeriodic, NULL, &g_odometry_timer_attributes);
+    g_odometry_timer_id = RTOS_API_TimerNew(Odometry_API_TimerCallback, osTimerPeriodic, NULL, &g_odometry_timer_attributes);
 
     if (NULL == g_odometry_timer_id) {
         return false;
     }
 
-    g_odometry_mutex = osMutexNew(&g_odometry_mutex_attributes);
+    g_odometry_mutex = RTOS_API_MutexNew(&g_odometry_mutex_attributes);
 
     if (NULL == g_odometry_mutex) {
         return false;
@@ -0,0 +1,290 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "packet_api.h"
+
+#if defined(ENABLE_PACKET)
+#include "cmsis_os2.h"
+#include "rtos_api.h"
+#include "debug_api.h"
+#include "uart_api.h"
+#include "cobs.h"
+#include "crc.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define PACKET_SEQUENCE_SIZE 1U
+#define PACKET_CRC_SIZE 2U
+#define PACKET_OVERHEAD_SIZE (PACKET_SEQUENCE_SIZE + PACKET_CRC_SIZE)
+#define PACKET_RAW_CAPACITY (PACKET_MAX_PAYLOAD_SIZE + PACKET_OVERHEAD_SIZE)
+#define PACKET_ENCODED_CAPACITY (COBS_MAX_ENCODED_SIZE(PACKET_RAW_CAPACITY) + 1U)
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+typedef struct sPacketDynamic {
+    bool is_init;
+    bool is_receive_framed;
+    osMutexId_t mutex;
+    uint8_t tx_sequence;
+    uint8_t rx_sequence;
+    bool is_rx_synced;
+    uint8_t raw_buffer[PACKET_RAW_CAPACITY];
+    uint8_t encoded_buffer[PACKET_ENCODED_CAPACITY];
+    sPacketStats_t stats;
+} sPacketDynamic_t;
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+#if defined(DEBUG_PACKET_API)
+CREATE_MODULE_NAME (PACKET_API)
+#else
+CREATE_MODULE_NAME_EMPTY
+#endif /* DEBUG_PACKET_API */
+
+static const osMutexAttr_t g_packet_api_mutex_attributes = {
+    .name = "Packet_API_mutex", 
+    .attr_bits = osMutexPrioInherit, 
+    .cb_mem = NULL, 
+    .cb_size = 0U
+};
+
+static const char g_packet_delimiter[] = {'\0'};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+static sPacketDynamic_t g_dynamic_packet_lut[eUart_Last] = {0};
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static bool Packet_API_Decode (const eUart_t uart, sPacket_t *packet);
+static bool Packet_API_IsPacketFraming (const eUart_t uart);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+static bool Packet_API_Decode (const eUart_t uart, sPacket_t *packet) {
+    uint8_t *data = (uint8_t*) packet->message.data;
+    size_t decoded_size = 0;
+
+    if (!COBS_Decode(data, packet->message.size, data, packet->message.size, &decoded_size) || (decoded_size < PACKET_OVERHEAD_SIZE)) {
+        g_dynamic_packet_lut[uart].stats.decode_errors++;
+
+        return false;
+    }
+
+    size_t crc_offset = decoded_size - PACKET_CRC_SIZE;
+    uint16_t crc = (uint16_t) (data[crc_offset] | (data[crc_offset + 1] << 8));
+
+    if (crc != CRC16_Calculate(data, crc_offset)) {
+        g_dynamic_packet_lut[uart].stats.crc_errors++;
+
+        return false;
+    }
+
+    packet->sequence = data[0];
+    packet->payload = &data[PACKET_SEQUENCE_SIZE];
+    packet->size = crc_offset - PACKET_SEQUENCE_SIZE;
+
+    if (g_dynamic_packet_lut[uart].is_rx_synced && (packet->sequence != g_dynamic_packet_lut[uart].rx_sequence)) {
+        g_dynamic_packet_lut[uart].stats.sequence_gaps += (uint8_t) (packet->sequence - g_dynamic_packet_lut[uart].rx_sequence);
+    }
+
+    g_dynamic_packet_lut[uart].rx_sequence = packet->sequence + 1;
+    g_dynamic_packet_lut[uart].is_rx_synced = true;
+    g_dynamic_packet_lut[uart].stats.received++;
+
+    return true;
+}
+
+/* A UART initialized earlier keeps its framing, only the 0x00 delimiter hands whole packets to Receive */
+static bool Packet_API_IsPacketFraming (const eUart_t uart) {
+    sUartFraming_t framing = {0};
+
+    if (!UART_API_GetFraming(uart, &framing)) {
+        return false;
+    }
+
+    if ((eUartFraming_Delimiter != framing.mode) || (sizeof(g_packet_delimiter) != framing.delimiter_length)) {
+        return false;
+    }
+
+    return (0 == memcmp(framing.delimiter, g_packet_delimiter, sizeof(g_packet_delimiter)));
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+bool Packet_API_Init (const eUart_t uart, const eBaudrate_t baudrate) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    if (g_dynamic_packet_lut[uart].is_init) {
+        return true;
+    }
+
+    sUartFraming_t framing = {.mode = eUartFraming_Delimiter, .delimiter = g_packet_delimiter, .delimiter_length = sizeof(g_packet_delimiter)};
+
+    if (!UART_API_InitFraming(uart, baudrate, &framing)) {
+        return false;
+    }
+
+    g_dynamic_packet_lut[uart].is_receive_framed = Packet_API_IsPacketFraming(uart);
+
+    if (!g_dynamic_packet_lut[uart].is_receive_framed) {
+        TRACE_WRN("Init: UART [%d] keeps its text framing, packets can only be sent\n", uart);
+    }
+
+    g_dynamic_packet_lut[uart].mutex = RTOS_API_MutexNew(&g_packet_api_mutex_attributes);
+
+    if (NULL == g_dynamic_packet_lut[uart].mutex) {
+        return false;
+    }
+
+    g_dynamic_packet_lut[uart].is_init = true;
+
+    return true;
+}
+
+bool Packet_API_Send (const eUart_t uart, const uint8_t *payload, const size_t size, const uint32_t timeout) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        TRACE_ERR("Send: Incorrect UART type [%d]\n", uart);
+
+        return false;
+    }
+
+    if (!g_dynamic_packet_lut[uart].is_init) {
+        TRACE_ERR("Send: Packet UART [%d] not initialized\n", uart);
+
+        return false;
+    }
+
+    if (((NULL == payload) && (0 != size)) || (size > PACKET_MAX_PAYLOAD_SIZE)) {
+        return false;
+    }
+
+    if (osOK != osMutexAcquire(g_dynamic_packet_lut[uart].mutex, timeout)) {
+        return false;
+    }
+
+    sPacketDynamic_t *dynamic = &g_dynamic_packet_lut[uart];
+
+    dynamic->raw_buffer[0] = dynamic->tx_sequence;
+
+    if (0 != size) {
+        memcpy(&dynamic->raw_buffer[PACKET_SEQUENCE_SIZE], payload, size);
+    }
+
+    size_t crc_offset = PACKET_SEQUENCE_SIZE + size;
+    uint16_t crc = CRC16_Calculate(dynamic->raw_buffer, crc_offset);
+
+    dynamic->raw_buffer[crc_offset] = (uint8_t) (crc & 0xFFU);
+    dynamic->raw_buffer[crc_offset + 1] = (uint8_t) (crc >> 8);
+
+    size_t encoded_size = 0;
+
+    if (!COBS_Encode(dynamic->raw_buffer, crc_offset + PACKET_CRC_SIZE, dynamic->encoded_buffer, sizeof(dynamic->encoded_buffer) - 1, &encoded_size)) {
+        osMutexRelease(dynamic->mutex);
+
+        return false;
+    }
+
+    dynamic->encoded_buffer[encoded_size++] = 0;
+
+    sMessage_t message = {.data = (char*) dynamic->encoded_buffer, .size = encoded_size};
+
+    if (!UART_API_Send(uart, message, timeout)) {
+        osMutexRelease(dynamic->mutex);
+
+        return false;
+    }
+
+    dynamic->tx_sequence++;
+    dynamic->stats.sent++;
+
+    osMutexRelease(dynamic->mutex);
+
+    return true;
+}
+
+/* Frames that fail to decode or fail the CRC are counted and released, the call then returns false */
+bool Packet_API_Receive (const eUart_t uart, sPacket_t *packet, const uint32_t timeout) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        TRACE_ERR("Receive: Incorrect UART type [%d]\n", uart);
+
+        return false;
+    }
+
+    if (!g_dynamic_packet_lut[uart].is_init) {
+        TRACE_ERR("Receive: Packet UART [%d] not initialized\n", uart);
+
+        return false;
+    }
+
+    if (NULL == packet) {
+        return false;
+    }
+
+    /* Text lines of a CLI sharing the UART are not packets, they must not be taken from the CLI or counted as errors */
+    if (!g_dynamic_packet_lut[uart].is_receive_framed) {
+        TRACE_ERR("Receive: UART [%d] not framed for packets\n", uart);
+
+        return false;
+    }
+
+    if (!UART_API_Receive(uart, &packet->message, timeout)) {
+        return false;
+    }
+
+    if (!Packet_API_Decode(uart, packet)) {
+        UART_API_Release(uart, &packet->message);
+
+        return false;
+    }
+
+    return true;
+}
+
+bool Packet_API_Release (const eUart_t uart, sPacket_t *packet) {
+    if (NULL == packet) {
+        return false;
+    }
+
+    packet->payload = NULL;
+    packet->size = 0;
+
+    return UART_API_Release(uart, &packet->message);
+}
+
+bool Packet_API_GetStats (const eUart_t uart, sPacketStats_t *stats) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    if (NULL == stats) {
+        return false;
+    }
+
+    *stats = g_dynamic_packet_lut[uart].stats;
+
+    return true;
+}
+
+#endif /* ENABLE_PACKET */
@@ -0,0 +1,59 @@
+#ifndef SOURCE_API_PACKET_API_H_
+#define SOURCE_API_PACKET_API_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "framework_config.h"
+
+#if defined(ENABLE_PACKET)
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "uart_config.h"
+#include "baudrate.h"
+#include "message.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef struct sPacket {
+    uint8_t sequence;
+    uint8_t *payload;           // Points into message, valid until Packet_API_Release
+    size_t size;
+    sMessage_t message;
+} sPacket_t;
+
+typedef struct sPacketStats {
+    uint32_t sent;
+    uint32_t received;
+    uint32_t decode_errors;
+    uint32_t crc_errors;
+    uint32_t sequence_gaps;
+} sPacketStats_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+/* Frames are COBS(sequence | payload | CRC-16 LE) and 0x00, a text framed UART (e.g. the CLI) can send but not receive them */
+/* Receiving needs Packet_API_Init to init the UART first, with buffer_capacity >= COBS_MAX_ENCODED_SIZE(PACKET_MAX_PAYLOAD_SIZE + 3) */
+bool Packet_API_Init (const eUart_t uart, const eBaudrate_t baudrate);
+bool Packet_API_Send (const eUart_t uart, const uint8_t *payload, const size_t size, const uint32_t timeout);
+bool Packet_API_Receive (const eUart_t uart, sPacket_t *packet, const uint32_t timeout);
+bool Packet_API_Release (const eUart_t uart, sPacket_t *packet);
+bool Packet_API_GetStats (const eUart_t uart, sPacketStats_t *stats);
+
+#endif /* ENABLE_PACKET */
+#endif /* SOURCE_API_PACKET_API_H_ */
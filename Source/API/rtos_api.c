@@ -0,0 +1,178 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "rtos_api.h"
+
+#if defined(RTOS_API_STATIC)
+#include <stdatomic.h>
+#include "FreeRTOS.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/* CMSIS-FreeRTOS returns NULL for any object with cb_mem set unless static allocation is enabled */
+#if !defined(configSUPPORT_STATIC_ALLOCATION) || (1 != configSUPPORT_STATIC_ALLOCATION)
+#error "RTOS_STATIC_ARENA_SIZE requires configSUPPORT_STATIC_ALLOCATION"
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#define RTOS_ARENA_ALIGNMENT sizeof(uint64_t)
+#define RTOS_ARENA_ALIGN_UP(size) (((size) + RTOS_ARENA_ALIGNMENT - 1U) & ~(RTOS_ARENA_ALIGNMENT - 1U))
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/* Control blocks, stacks and queue storage of every framework object, carved once at init and never returned */
+static uint64_t g_rtos_arena[RTOS_ARENA_ALIGN_UP(RTOS_STATIC_ARENA_SIZE) / sizeof(uint64_t)] = {0};
+static atomic_size_t g_rtos_arena_used = 0;
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static void *RTOS_API_ArenaAllocate (const size_t size);
+static bool RTOS_API_AssignMemory (void **memory, uint32_t *memory_size, const size_t size);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/* Lock-free bump allocation, objects may be created from several threads while the framework starts */
+static void *RTOS_API_ArenaAllocate (const size_t size) {
+    size_t aligned_size = RTOS_ARENA_ALIGN_UP(size);
+    size_t used = atomic_load_explicit(&g_rtos_arena_used, memory_order_relaxed);
+
+    do {
+        if (aligned_size > (sizeof(g_rtos_arena) - used)) {
+            return NULL;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&g_rtos_arena_used, &used, used + aligned_size, memory_order_relaxed, memory_order_relaxed));
+
+    return (uint8_t *) g_rtos_arena + used;
+}
+
+/* Memory the configuration already supplied is kept, only missing blocks come from the arena */
+static bool RTOS_API_AssignMemory (void **memory, uint32_t *memory_size, const size_t size) {
+    if (NULL != *memory) {
+        return true;
+    }
+
+    *memory = RTOS_API_ArenaAllocate(size);
+    *memory_size = (uint32_t) size;
+
+    return (NULL != *memory);
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+osThreadId_t RTOS_API_ThreadNew (osThreadFunc_t function, void *argument, const osThreadAttr_t *attributes) {
+    osThreadAttr_t static_attributes = {0};
+
+    if (NULL != attributes) {
+        static_attributes = *attributes;
+    }
+
+    if (0 == static_attributes.stack_size) {
+        static_attributes.stack_size = configMINIMAL_STACK_SIZE * sizeof(StackType_t);
+    }
+
+    if (!RTOS_API_AssignMemory(&static_attributes.cb_mem, &static_attributes.cb_size, sizeof(StaticTask_t))) {
+        return NULL;
+    }
+
+    if (!RTOS_API_AssignMemory(&static_attributes.stack_mem, &static_attributes.stack_size, static_attributes.stack_size)) {
+        return NULL;
+    }
+
+    return osThreadNew(function, argument, &static_attributes);
+}
+
+osMutexId_t RTOS_API_MutexNew (const osMutexAttr_t *attributes) {
+    osMutexAttr_t static_attributes = {0};
+
+    if (NULL != attributes) {
+        static_attributes = *attributes;
+    }
+
+    if (!RTOS_API_AssignMemory(&static_attributes.cb_mem, &static_attributes.cb_size, sizeof(StaticSemaphore_t))) {
+        return NULL;
+    }
+
+    return osMutexNew(&static_attributes);
+}
+
+osTimerId_t RTOS_API_TimerNew (osTimerFunc_t function, osTimerType_t type, void *argument, const osTimerAttr_t *attributes) {
+    osTimerAttr_t static_attributes = {0};
+
+    if (NULL != attributes) {
+        static_attributes = *attributes;
+    }
+
+    if (!RTOS_API_AssignMemory(&static_attributes.cb_mem, &static_attributes.cb_size, sizeof(StaticTimer_t))) {
+        return NULL;
+    }
+
+    return osTimerNew(function, type, argument, &static_attributes);
+}
+
+osEventFlagsId_t RTOS_API_EventFlagsNew (const osEventFlagsAttr_t *attributes) {
+    osEventFlagsAttr_t static_attributes = {0};
+
+    if (NULL != attributes) {
+        static_attributes = *attributes;
+    }
+
+    if (!RTOS_API_AssignMemory(&static_attributes.cb_mem, &static_attributes.cb_size, sizeof(StaticEventGroup_t))) {
+        return NULL;
+    }
+
+    return osEventFlagsNew(&static_attributes);
+}
+
+osMessageQueueId_t RTOS_API_MessageQueueNew (const uint32_t message_count, const uint32_t message_size, const osMessageQueueAttr_t *attributes) {
+    osMessageQueueAttr_t static_attributes = {0};
+
+    if (NULL != attributes) {
+        static_attributes = *attributes;
+    }
+
+    if (!RTOS_API_AssignMemory(&static_attributes.cb_mem, &static_attributes.cb_size, sizeof(StaticQueue_t))) {
+        return NULL;
+    }
+
+    if (!RTOS_API_AssignMemory(&static_attributes.mq_mem, &static_attributes.mq_size, (size_t) message_count * message_size)) {
+        return NULL;
+    }
+
+    return osMessageQueueNew(message_count, message_size, &static_attributes);
+}
+
+/* Shrink RTOS_STATIC_ARENA_SIZE to the used figure once every module is up, the map file then shows the exact cost */
+bool RTOS_API_GetArenaUsage (size_t *used, size_t *capacity) {
+    if ((NULL == used) || (NULL == capacity)) {
+        return false;
+    }
+
+    *used = atomic_load_explicit(&g_rtos_arena_used, memory_order_relaxed);
+    *capacity = sizeof(g_rtos_arena);
+
+    return true;
+}
+
+#endif /* RTOS_API_STATIC */
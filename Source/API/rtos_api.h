@@ -0,0 +1,50 @@
+#ifndef SOURCE_API_RTOS_API_H_
+#define SOURCE_API_RTOS_API_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "framework_config.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "cmsis_os2.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+#if defined(RTOS_STATIC_ARENA_SIZE)
+#define RTOS_API_STATIC
+#else
+/* Without the static arena every object comes from the RTOS heap exactly as before */
+#define RTOS_API_ThreadNew(function, argument, attributes) osThreadNew(function, argument, attributes)
+#define RTOS_API_MutexNew(attributes) osMutexNew(attributes)
+#define RTOS_API_TimerNew(function, type, argument, attributes) osTimerNew(function, type, argument, attributes)
+#define RTOS_API_EventFlagsNew(attributes) osEventFlagsNew(attributes)
+#define RTOS_API_MessageQueueNew(message_count, message_size, attributes) osMessageQueueNew(message_count, message_size, attributes)
+#endif /* RTOS_STATIC_ARENA_SIZE */
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+#if defined(RTOS_API_STATIC)
+osThreadId_t RTOS_API_ThreadNew (osThreadFunc_t function, void *argument, const osThreadAttr_t *attributes);
+osMutexId_t RTOS_API_MutexNew (const osMutexAttr_t *attributes);
+osTimerId_t RTOS_API_TimerNew (osTimerFunc_t function, osTimerType_t type, void *argument, const osTimerAttr_t *attributes);
+osEventFlagsId_t RTOS_API_EventFlagsNew (const osEventFlagsAttr_t *attributes);
+osMessageQueueId_t RTOS_API_MessageQueueNew (const uint32_t message_count, const uint32_t message_size, const osMessageQueueAttr_t *attributes);
+bool RTOS_API_GetArenaUsage (size_t *used, size_t *capacity);
+#endif /* RTOS_API_STATIC */
+
+#endif /* SOURCE_API_RTOS_API_H_ */
@@ -6,15 +6,32 @@
 
 #if defined(ENABLE_UART)
 #include "cmsis_os2.h"
+#include "rtos_api.h"
 #include "debug_api.h"
 #include "heap_api.h"
 #include "uart_driver.h"
 #include "gpio_driver.h"
+#include "typed_ring_buffer.h"
+#include <stdatomic.h>
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
+#define UART_TX_DONE_RING_CAPACITY 8U
+#define UART_TX_DONE_FLAG 0x01U
+
+#define UART_RX_FLAG(uart) (1UL << (uart))
+#define UART_RX_FLAGS_ALL (UART_RX_FLAG(eUart_Last) - 1UL)
+#define UART_FSM_RETRY_TIMEOUT 10U
+#define UART_LENGTH_PREFIX_MAX_SIZE sizeof(uint32_t)
+
+/* Enough for a full message queue, the message being collected and one held by the receiver */
+#define UART_MESSAGE_POOL_SIZE (MESSAGE_QUEUE_CAPACITY + 2U)
+#define UART_MESSAGE_POOL_MASK ((uint32_t) ((1ULL << UART_MESSAGE_POOL_SIZE) - 1ULL))
+
+_Static_assert(UART_MESSAGE_POOL_SIZE <= 32U, "UART message pool is tracked in a 32-bit free mask");
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
@@ -28,13 +45,47 @@ typedef enum eState {
     eState_Last
 } eState_t;
 
+typedef enum eFrameState {
+    eFrameState_First,
+    eFrameState_Incomplete = eFrameState_First,
+    eFrameState_Complete,
+    eFrameState_Skipped,
+    eFrameState_Last
+} eFrameState_t;
+
+typedef struct sFrame {
+    size_t offset;
+    size_t size;
+    size_t end;
+} sFrame_t;
+
+typedef struct sUartTxDone {
+    size_t ticket;
+    uart_send_callback_t callback;
+    void *context;
+} sUartTxDone_t;
+
+TYPED_RING_BUFFER_DEFINE(UART_API_TxDoneRing, sUartTxDone_t, UART_TX_DONE_RING_CAPACITY)
+
 typedef struct sUartApiDynamic {
+    eUart_t uart;
     eState_t current_state;
     osMutexId_t mutex_send;
     osMessageQueueId_t message_queue;
     sMessage_t message;
     char *delimiter;
     size_t delimiter_length;
+    size_t rx_position;
+    bool is_rx_overwritten;
+    size_t scan_offset;
+    size_t discard_size;
+    size_t gap_pending_size;
+    uint32_t gap_tick;
+    char *pool;
+    atomic_uint_least32_t pool_free_mask;
+    osEventFlagsId_t tx_event;
+    size_t tx_queued;
+    UART_API_TxDoneRing_t tx_done;
 } sUartDynamic_t;
 
 /**********************************************************************************************************************
@@ -52,8 +103,10 @@ CREATE_MODULE_NAME_EMPTY
  *********************************************************************************************************************/
 
 static osThreadId_t g_fsm_thread_id = NULL;
+static uint32_t g_fsm_wakeup_count = 0;
 
 static sUartApiConst_t g_static_uart_lut[eUart_Last] = {0};
+static sUartFraming_t g_static_framing_lut[eUart_Last] = {0};
 static sUartDynamic_t g_dynamic_uart_lut[eUart_Last] = {0};
 
 /**********************************************************************************************************************
@@ -65,101 +118,445 @@ static sUartDynamic_t g_dynamic_uart_lut[eUart_Last] = {0};
  *********************************************************************************************************************/
 
 static void UART_API_FsmThread (void *arg);
-static bool UART_API_IsDelimiterReceived (const eUart_t uart);
-static void UART_API_BufferIncrement (const eUart_t uart);
+static bool UART_API_ServiceUart (const eUart_t uart);
+static void UART_API_ReceiveCallback (void *context);
+static uint8_t UART_API_GetSpanByte (const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, const size_t offset);
+static bool UART_API_IsDelimiterAt (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, const size_t offset);
+static bool UART_API_FindDelimiter (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, size_t *frame_end);
+static void UART_API_CopyFromSpans (char *destination, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, const size_t offset, const size_t size);
+static bool UART_API_ConsumeBytes (const eUart_t uart, const size_t size);
+static void UART_API_ResetFrame (const eUart_t uart);
+static eFrameState_t UART_API_FindFrame (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, sFrame_t *frame);
+static eFrameState_t UART_API_FindDelimiterFrame (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, sFrame_t *frame);
+static eFrameState_t UART_API_FindLengthPrefixFrame (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, sFrame_t *frame);
+static eFrameState_t UART_API_FindTimeoutFrame (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, sFrame_t *frame);
+static uint32_t UART_API_GetServiceTimeout (const eUart_t uart);
+static char *UART_API_AcquireBuffer (const eUart_t uart);
+static void UART_API_TransmitCallback (void *context, const size_t transmitted);
+static bool UART_API_WaitTransmit (const eUart_t uart, const uint32_t start_tick, const uint32_t timeout);
 
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
-// TODO: Refactor thread to use event flags or something to avoid busy waiting
-// TODO: Add enum in static lut to select between message/delimiter modes, i.e. read until delimiter or include payload length
 static void UART_API_FsmThread (void *arg) {
+    uint32_t pending_flags = UART_RX_FLAGS_ALL;
+
     while (1) {
+        uint32_t wait_timeout = osWaitForever;
+
         for (eUart_t uart = eUart_First; uart < eUart_Last; uart++) {
             if (eState_Uninitialized == g_dynamic_uart_lut[uart].current_state) {
                 continue;
             }
 
-            switch (g_dynamic_uart_lut[uart].current_state) {
-                case eState_Setup: {
-                    g_dynamic_uart_lut[uart].message.data = Heap_API_Calloc(g_static_uart_lut[uart].buffer_capacity, sizeof(char));
-                    
-                    if (NULL == g_dynamic_uart_lut[uart].message.data) {
-                        TRACE_WRN("FsmThread: Failed to allocate buffer for UART [%d]\n", uart);
-                        
-                        continue;
-                    }
-                    
-                    g_dynamic_uart_lut[uart].message.size = 0;
-                    g_dynamic_uart_lut[uart].current_state = eState_Collect;
-                    /* fall through */
-                }
-                case eState_Collect: {
-                    uint8_t received_byte = 0;
+            if ((0 == (pending_flags & UART_RX_FLAG(uart))) && (osWaitForever == UART_API_GetServiceTimeout(uart))) {
+                continue;
+            }
 
-                    while (UART_Driver_ReceiveByte(uart, &received_byte)) {
-                        g_dynamic_uart_lut[uart].message.data[g_dynamic_uart_lut[uart].message.size] = received_byte;
+            while (UART_API_ServiceUart(uart)) {}
 
-                        UART_API_BufferIncrement(uart);
+            uint32_t service_timeout = UART_API_GetServiceTimeout(uart);
 
-                        if (!UART_API_IsDelimiterReceived(uart)) {
-                            continue;
-                        }
+            if (service_timeout < wait_timeout) {
+                wait_timeout = service_timeout;
+            }
+        }
 
-                        g_dynamic_uart_lut[uart].message.size -= g_dynamic_uart_lut[uart].delimiter_length;
-                        g_dynamic_uart_lut[uart].message.data[g_dynamic_uart_lut[uart].message.size] = '\0';
+        /* Sleeps until an RX interrupt flags a UART or a UART asks to be serviced again after a timeout */
+        pending_flags = osThreadFlagsWait(UART_RX_FLAGS_ALL, osFlagsWaitAny, wait_timeout);
 
-                        g_dynamic_uart_lut[uart].current_state = eState_Flush;
+        if (0 != (pending_flags & osFlagsError)) {
+            pending_flags = 0;
+        }
 
-                        break;
-                    }
+        g_fsm_wakeup_count++;
+    }
+}
 
-                    if (eState_Flush != g_dynamic_uart_lut[uart].current_state) {
-                        continue;
-                    }
-                    /* fall through */
-                }
-                case eState_Flush: {
-                    if (osOK != osMessageQueuePut(g_dynamic_uart_lut[uart].message_queue, &g_dynamic_uart_lut[uart].message, MESSAGE_QUEUE_PRIORITY, MESSAGE_QUEUE_PUT_TIMEOUT)) {
-                        TRACE_ERR("FsmThread: Failed to put message in queue for UART [%d]\n", uart);
-                        
-                        continue;
-                    }
-
-                    g_dynamic_uart_lut[uart].current_state = eState_Setup;
-                } break;
-                default: {  
+/* Runs the state machine once, returns true when a frame was taken out of the ring and more may be pending */
+static bool UART_API_ServiceUart (const eUart_t uart) {
+    switch (g_dynamic_uart_lut[uart].current_state) {
+        case eState_Setup: {
+            g_dynamic_uart_lut[uart].message.data = UART_API_AcquireBuffer(uart);
+            
+            /* Backpressure, received bytes wait in the RX ring until UART_API_Release wakes the thread */
+            if (NULL == g_dynamic_uart_lut[uart].message.data) {
+                return false;
+            }
+            
+            g_dynamic_uart_lut[uart].message.size = 0;
+            g_dynamic_uart_lut[uart].current_state = eState_Collect;
+            /* fall through */
+        }
+        case eState_Collect: {
+            sRingBufferSpan_t first = {0};
+            sRingBufferSpan_t second = {0};
+            sFrame_t frame = {0};
+            size_t position = 0;
+
+            if (!UART_Driver_PeekBytes(uart, &position, &first, &second)) {
+                return false;
+            }
+
+            /* A DMA RX ring moves its tail by itself when it overwrites unread bytes, the frame they started is lost */
+            if (position != g_dynamic_uart_lut[uart].rx_position) {
+                UART_API_ResetFrame(uart);
+
+                g_dynamic_uart_lut[uart].rx_position = position;
+                g_dynamic_uart_lut[uart].is_rx_overwritten = true;
+            }
+
+            switch (UART_API_FindFrame(uart, &first, &second, &frame)) {
+                case eFrameState_Complete: {
                 } break;
+                case eFrameState_Skipped: {
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+
+            /* The first frame after an overwrite starts somewhere inside the lost one, it is dropped too */
+            if (g_dynamic_uart_lut[uart].is_rx_overwritten) {
+                TRACE_WRN("FsmThread: UART [%d] receive ring overwritten, frame dropped\n", uart);
+
+                g_dynamic_uart_lut[uart].is_rx_overwritten = false;
+                UART_API_ConsumeBytes(uart, frame.end);
+
+                return true;
+            }
+
+            UART_API_CopyFromSpans(g_dynamic_uart_lut[uart].message.data, &first, &second, frame.offset, frame.size);
+
+            /* Bytes overwritten while they were copied make the consume fail, the next peek then sees the moved tail */
+            if (!UART_API_ConsumeBytes(uart, frame.end)) {
+                return true;
             }
 
-            osThreadYield();
+            g_dynamic_uart_lut[uart].message.size = frame.size;
+            g_dynamic_uart_lut[uart].message.data[frame.size] = '\0';
+
+            g_dynamic_uart_lut[uart].current_state = eState_Flush;
+            /* fall through */
+        }
+        case eState_Flush: {
+            if (osOK != osMessageQueuePut(g_dynamic_uart_lut[uart].message_queue, &g_dynamic_uart_lut[uart].message, MESSAGE_QUEUE_PRIORITY, MESSAGE_QUEUE_PUT_TIMEOUT)) {
+                TRACE_ERR("FsmThread: Failed to put message in queue for UART [%d]\n", uart);
+                
+                return false;
+            }
+
+            g_dynamic_uart_lut[uart].current_state = eState_Setup;
+
+            return true;
+        }
+        default: {  
+        } break;
+    }
+
+    return false;
+}
+
+/* Full queues are retried periodically, a pending timeout frame is checked once its gap may have passed */
+static uint32_t UART_API_GetServiceTimeout (const eUart_t uart) {
+    switch (g_dynamic_uart_lut[uart].current_state) {
+        case eState_Flush: {
+            return UART_FSM_RETRY_TIMEOUT;
+        }
+        case eState_Collect: {
+            if ((eUartFraming_Timeout == g_static_framing_lut[uart].mode) && (0 != g_dynamic_uart_lut[uart].gap_pending_size)) {
+                return g_static_framing_lut[uart].gap_timeout;
+            }
+        } break;
+        default: {
+        } break;
+    }
+
+    return osWaitForever;
+}
+
+static char *UART_API_AcquireBuffer (const eUart_t uart) {
+    uint32_t free_mask = atomic_load_explicit(&g_dynamic_uart_lut[uart].pool_free_mask, memory_order_acquire);
+
+    while (0 != free_mask) {
+        uint32_t index = (uint32_t) __builtin_ctz(free_mask);
+
+        if (atomic_compare_exchange_weak_explicit(&g_dynamic_uart_lut[uart].pool_free_mask, &free_mask, free_mask & ~(1UL << index), memory_order_acq_rel, memory_order_acquire)) {
+            return &g_dynamic_uart_lut[uart].pool[index * g_static_uart_lut[uart].buffer_capacity];
+        }
+    }
+
+    return NULL;
+}
+
+static void UART_API_ReceiveCallback (void *context) {
+    if ((NULL == context) || (NULL == g_fsm_thread_id)) {
+        return;
+    }
+
+    sUartDynamic_t *dynamic = (sUartDynamic_t*) context;
+
+    osThreadFlagsSet(g_fsm_thread_id, UART_RX_FLAG(dynamic->uart));
+
+    return;
+}
+
+static uint8_t UART_API_GetSpanByte (const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, const size_t offset) {
+    if (offset < first->size) {
+        return first->data[offset];
+    }
+
+    return second->data[offset - first->size];
+}
+
+static bool UART_API_IsDelimiterAt (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, const size_t offset) {
+    for (size_t i = 0; i < g_dynamic_uart_lut[uart].delimiter_length; i++) {
+        if ((uint8_t) g_dynamic_uart_lut[uart].delimiter[i] != UART_API_GetSpanByte(first, second, offset + i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool UART_API_FindDelimiter (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, size_t *frame_end) {
+    const size_t available = first->size + second->size;
+    const size_t delimiter_length = g_dynamic_uart_lut[uart].delimiter_length;
+    const uint8_t last_character = (uint8_t) g_dynamic_uart_lut[uart].delimiter[delimiter_length - 1];
+
+    /* scan_offset is the next position that may hold the last delimiter character, so old bytes are not rescanned */
+    size_t offset = g_dynamic_uart_lut[uart].scan_offset;
+
+    while (offset < available) {
+        const uint8_t *found = NULL;
+
+        if (offset < first->size) {
+            found = memchr(&first->data[offset], last_character, first->size - offset);
+            offset = (NULL != found) ? (size_t) (found - first->data) : first->size;
+        } else {
+            found = memchr(&second->data[offset - first->size], last_character, available - offset);
+            offset = (NULL != found) ? (size_t) (found - second->data) + first->size : available;
+        }
+
+        if (NULL == found) {
+            continue;
         }
+
+        if (UART_API_IsDelimiterAt(uart, first, second, offset + 1 - delimiter_length)) {
+            *frame_end = offset + 1;
+
+            return true;
+        }
+
+        offset++;
     }
+
+    g_dynamic_uart_lut[uart].scan_offset = offset;
+
+    return false;
 }
 
-static void UART_API_BufferIncrement (const eUart_t uart) {
-    g_dynamic_uart_lut[uart].message.size++;
+static void UART_API_CopyFromSpans (char *destination, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, const size_t offset, const size_t size) {
+    if (offset >= first->size) {
+        memcpy(destination, &second->data[offset - first->size], size);
 
-    if (g_dynamic_uart_lut[uart].message.size >= g_static_uart_lut[uart].buffer_capacity) {
-        g_dynamic_uart_lut[uart].message.size = 0;
+        return;
     }
 
+    size_t first_size = ((first->size - offset) < size) ? (first->size - offset) : size;
+
+    memcpy(destination, &first->data[offset], first_size);
+    memcpy(&destination[first_size], second->data, size - first_size);
+
     return;
 }
 
-static bool UART_API_IsDelimiterReceived (const eUart_t uart) {
-    if (g_dynamic_uart_lut[uart].message.size < g_dynamic_uart_lut[uart].delimiter_length) {
+/* Consumes relative to the position the frame was peeked at, so a tail moved by the DMA producer is never skipped past */
+static bool UART_API_ConsumeBytes (const eUart_t uart, const size_t size) {
+    if (!UART_Driver_ConsumeBytes(uart, g_dynamic_uart_lut[uart].rx_position, size)) {
         return false;
     }
-    
-    if (g_dynamic_uart_lut[uart].delimiter[g_dynamic_uart_lut[uart].delimiter_length - 1] != g_dynamic_uart_lut[uart].message.data[g_dynamic_uart_lut[uart].message.size - 1]) {
+
+    g_dynamic_uart_lut[uart].rx_position += size;
+
+    return true;
+}
+
+/* Scan progress is relative to the ring tail, it starts over when the tail moved without the FSM */
+static void UART_API_ResetFrame (const eUart_t uart) {
+    if (eUartFraming_Delimiter == g_static_framing_lut[uart].mode) {
+        g_dynamic_uart_lut[uart].scan_offset = g_dynamic_uart_lut[uart].delimiter_length - 1;
+    }
+
+    g_dynamic_uart_lut[uart].discard_size = 0;
+    g_dynamic_uart_lut[uart].gap_pending_size = 0;
+
+    return;
+}
+
+static eFrameState_t UART_API_FindFrame (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, sFrame_t *frame) {
+    switch (g_static_framing_lut[uart].mode) {
+        case eUartFraming_Delimiter: {
+            return UART_API_FindDelimiterFrame(uart, first, second, frame);
+        }
+        case eUartFraming_LengthPrefix: {
+            return UART_API_FindLengthPrefixFrame(uart, first, second, frame);
+        }
+        case eUartFraming_Timeout: {
+            return UART_API_FindTimeoutFrame(uart, first, second, frame);
+        }
+        default: {
+        } break;
+    }
+
+    return eFrameState_Incomplete;
+}
+
+static eFrameState_t UART_API_FindDelimiterFrame (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, sFrame_t *frame) {
+    const size_t delimiter_length = g_dynamic_uart_lut[uart].delimiter_length;
+
+    if (!UART_API_FindDelimiter(uart, first, second, &frame->end)) {
+        size_t pending_size = g_dynamic_uart_lut[uart].scan_offset - (delimiter_length - 1);
+
+        if ((pending_size < g_static_uart_lut[uart].buffer_capacity) && !UART_Driver_IsReceiveBufferFull(uart)) {
+            return eFrameState_Incomplete;
+        }
+
+        UART_API_ConsumeBytes(uart, pending_size);
+
+        g_dynamic_uart_lut[uart].scan_offset = delimiter_length - 1;
+
+        return eFrameState_Skipped;
+    }
+
+    g_dynamic_uart_lut[uart].scan_offset = delimiter_length - 1;
+
+    frame->offset = 0;
+    frame->size = frame->end - delimiter_length;
+
+    if (frame->size >= g_static_uart_lut[uart].buffer_capacity) {
+        UART_API_ConsumeBytes(uart, frame->end);
+
+        return eFrameState_Skipped;
+    }
+
+    return eFrameState_Complete;
+}
+
+static eFrameState_t UART_API_FindLengthPrefixFrame (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, sFrame_t *frame) {
+    const size_t available = first->size + second->size;
+    const size_t length_size = g_static_framing_lut[uart].length_size;
+
+    /* Payload of an oversized frame is dropped as it arrives, so it is never parsed as a header */
+    if (0 != g_dynamic_uart_lut[uart].discard_size) {
+        size_t discard_size = (available < g_dynamic_uart_lut[uart].discard_size) ? available : g_dynamic_uart_lut[uart].discard_size;
+
+        UART_API_ConsumeBytes(uart, discard_size);
+
+        g_dynamic_uart_lut[uart].discard_size -= discard_size;
+
+        return (0 != discard_size) ? eFrameState_Skipped : eFrameState_Incomplete;
+    }
+
+    if (available < length_size) {
+        return eFrameState_Incomplete;
+    }
+
+    size_t payload_size = 0;
+
+    for (size_t i = 0; i < length_size; i++) {
+        payload_size |= (size_t) UART_API_GetSpanByte(first, second, i) << (i * 8);
+    }
+
+    if (payload_size >= g_static_uart_lut[uart].buffer_capacity) {
+        g_dynamic_uart_lut[uart].discard_size = length_size + payload_size;
+
+        return eFrameState_Skipped;
+    }
+
+    if (available < (length_size + payload_size)) {
+        return eFrameState_Incomplete;
+    }
+
+    frame->offset = length_size;
+    frame->size = payload_size;
+    frame->end = length_size + payload_size;
+
+    return eFrameState_Complete;
+}
+
+/* Modbus-RTU style, everything received before a quiet gap on the line is one frame */
+static eFrameState_t UART_API_FindTimeoutFrame (const eUart_t uart, const sRingBufferSpan_t *first, const sRingBufferSpan_t *second, sFrame_t *frame) {
+    const size_t available = first->size + second->size;
+    const uint32_t current_tick = osKernelGetTickCount();
+
+    if (0 == available) {
+        return eFrameState_Incomplete;
+    }
+
+    if ((available >= g_static_uart_lut[uart].buffer_capacity) || UART_Driver_IsReceiveBufferFull(uart)) {
+        UART_API_ConsumeBytes(uart, available);
+
+        g_dynamic_uart_lut[uart].gap_pending_size = 0;
+
+        return eFrameState_Skipped;
+    }
+
+    if (available != g_dynamic_uart_lut[uart].gap_pending_size) {
+        g_dynamic_uart_lut[uart].gap_pending_size = available;
+        g_dynamic_uart_lut[uart].gap_tick = current_tick;
+
+        return eFrameState_Incomplete;
+    }
+
+    if ((current_tick - g_dynamic_uart_lut[uart].gap_tick) < g_static_framing_lut[uart].gap_timeout) {
+        return eFrameState_Incomplete;
+    }
+
+    g_dynamic_uart_lut[uart].gap_pending_size = 0;
+
+    frame->offset = 0;
+    frame->size = available;
+    frame->end = available;
+
+    return eFrameState_Complete;
+}
+
+static void UART_API_TransmitCallback (void *context, const size_t transmitted) {
+    if (NULL == context) {
+        return;
+    }
+
+    sUartDynamic_t *dynamic = (sUartDynamic_t*) context;
+    sUartTxDone_t done = {0};
+
+    /* Tickets are the free-running byte count at the end of each message */
+    while (UART_API_TxDoneRing_Peek(&dynamic->tx_done, &done)) {
+        if ((ptrdiff_t) (transmitted - done.ticket) < 0) {
+            break;
+        }
+
+        UART_API_TxDoneRing_Pop(&dynamic->tx_done, &done);
+
+        done.callback(done.context);
+    }
+
+    osEventFlagsSet(dynamic->tx_event, UART_TX_DONE_FLAG);
+
+    return;
+}
+
+/* Waits for the transmitter to free ring space or done slots, false once the timeout counted from start_tick expires */
+static bool UART_API_WaitTransmit (const eUart_t uart, const uint32_t start_tick, const uint32_t timeout) {
+    uint32_t elapsed_ms = osKernelGetTickCount() - start_tick;
+
+    if (elapsed_ms >= timeout) {
         return false;
-    } 
-    
-    size_t start_pos = g_dynamic_uart_lut[uart].message.size - g_dynamic_uart_lut[uart].delimiter_length;
+    }
 
-    return (0 == memcmp(&g_dynamic_uart_lut[uart].message.data[start_pos], g_dynamic_uart_lut[uart].delimiter, g_dynamic_uart_lut[uart].delimiter_length));
+    return (0 == (osEventFlagsWait(g_dynamic_uart_lut[uart].tx_event, UART_TX_DONE_FLAG, osFlagsWaitAny, timeout - elapsed_ms) & osFlagsError));
 }
 
 /**********************************************************************************************************************
@@ -167,6 +564,12 @@ static bool UART_API_IsDelimiterReceived (const eUart_t uart) {
  *********************************************************************************************************************/
 
 bool UART_API_Init (const eUart_t uart, const eBaudrate_t baudrate, const char *delimiter) {
+    sUartFraming_t framing = {.mode = eUartFraming_Delimiter, .delimiter = delimiter};
+
+    return UART_API_InitFraming(uart, baudrate, &framing);
+}
+
+bool UART_API_InitFraming (const eUart_t uart, const eBaudrate_t baudrate, const sUartFraming_t *framing) {
     if (!UART_Config_IsCorrectUart(uart)) {
         return false;
     }
@@ -179,10 +582,31 @@ bool UART_API_Init (const eUart_t uart, const eBaudrate_t baudrate, const char *
         return false;
     }
 
-    if (NULL == delimiter) {
+    if (NULL == framing) {
         return false;
     }
 
+    switch (framing->mode) {
+        case eUartFraming_Delimiter: {
+            if ((NULL == framing->delimiter) || ((0 == framing->delimiter_length) && ('\0' == framing->delimiter[0]))) {
+                return false;
+            }
+        } break;
+        case eUartFraming_LengthPrefix: {
+            if ((0 == framing->length_size) || (framing->length_size > UART_LENGTH_PREFIX_MAX_SIZE)) {
+                return false;
+            }
+        } break;
+        case eUartFraming_Timeout: {
+            if (0 == framing->gap_timeout) {
+                return false;
+            }
+        } break;
+        default: {
+            return false;
+        }
+    }
+
     if (!GPIO_Driver_InitAllPins()) {
         return false;
     }
@@ -199,42 +623,97 @@ bool UART_API_Init (const eUart_t uart, const eBaudrate_t baudrate, const char *
         return false;
     }
 
-    g_dynamic_uart_lut[uart].mutex_send = osMutexNew(&g_static_uart_lut[uart].mutex_send_attributes);
+    g_dynamic_uart_lut[uart].mutex_send = RTOS_API_MutexNew(&g_static_uart_lut[uart].mutex_send_attributes);
     
     if (NULL == g_dynamic_uart_lut[uart].mutex_send) {
         return false;
     }
 
-    g_dynamic_uart_lut[uart].message_queue = osMessageQueueNew(MESSAGE_QUEUE_CAPACITY, sizeof(sMessage_t), &g_static_uart_lut[uart].message_queue_attributes);
+    g_dynamic_uart_lut[uart].message_queue = RTOS_API_MessageQueueNew(MESSAGE_QUEUE_CAPACITY, sizeof(sMessage_t), &g_static_uart_lut[uart].message_queue_attributes);
 
     if (NULL == g_dynamic_uart_lut[uart].message_queue) {
         return false;
     }
 
-    g_dynamic_uart_lut[uart].delimiter_length = strlen(delimiter);
-    g_dynamic_uart_lut[uart].delimiter = Heap_API_Calloc((g_dynamic_uart_lut[uart].delimiter_length + 1), sizeof(char));
+    /* One allocation at init, messages are handed out from this pool and returned with UART_API_Release */
+    g_dynamic_uart_lut[uart].pool = Heap_API_Calloc(UART_MESSAGE_POOL_SIZE, g_static_uart_lut[uart].buffer_capacity);
 
-    if (NULL == g_dynamic_uart_lut[uart].delimiter) {
+    if (NULL == g_dynamic_uart_lut[uart].pool) {
         return false;
     }
 
-    memcpy(g_dynamic_uart_lut[uart].delimiter, delimiter, g_dynamic_uart_lut[uart].delimiter_length + 1);
+    atomic_store_explicit(&g_dynamic_uart_lut[uart].pool_free_mask, UART_MESSAGE_POOL_MASK, memory_order_release);
+
+    g_static_framing_lut[uart] = *framing;
+
+    if (eUartFraming_Delimiter == framing->mode) {
+        g_dynamic_uart_lut[uart].delimiter_length = (0 != framing->delimiter_length) ? framing->delimiter_length : strlen(framing->delimiter);
+        g_dynamic_uart_lut[uart].delimiter = Heap_API_Calloc((g_dynamic_uart_lut[uart].delimiter_length + 1), sizeof(char));
+
+        if (NULL == g_dynamic_uart_lut[uart].delimiter) {
+            return false;
+        }
+
+        memcpy(g_dynamic_uart_lut[uart].delimiter, framing->delimiter, g_dynamic_uart_lut[uart].delimiter_length);
+
+        g_dynamic_uart_lut[uart].scan_offset = g_dynamic_uart_lut[uart].delimiter_length - 1;
+
+        g_static_framing_lut[uart].delimiter = g_dynamic_uart_lut[uart].delimiter;
+        g_static_framing_lut[uart].delimiter_length = g_dynamic_uart_lut[uart].delimiter_length;
+    }
+
+    g_dynamic_uart_lut[uart].discard_size = 0;
+    g_dynamic_uart_lut[uart].gap_pending_size = 0;
+
+    /* Only the position is wanted here, the peek itself fails while nothing was received yet */
+    sRingBufferSpan_t first = {0};
+    sRingBufferSpan_t second = {0};
+
+    UART_Driver_PeekBytes(uart, &g_dynamic_uart_lut[uart].rx_position, &first, &second);
+    g_dynamic_uart_lut[uart].is_rx_overwritten = false;
+
+    if (UART_Driver_IsTransmitAsync(uart)) {
+        g_dynamic_uart_lut[uart].tx_event = RTOS_API_EventFlagsNew(NULL);
+
+        if (NULL == g_dynamic_uart_lut[uart].tx_event) {
+            return false;
+        }
+
+        g_dynamic_uart_lut[uart].tx_queued = 0;
+        UART_API_TxDoneRing_Reset(&g_dynamic_uart_lut[uart].tx_done);
+
+        if (!UART_Driver_SetTransmitCallback(uart, &UART_API_TransmitCallback, &g_dynamic_uart_lut[uart])) {
+            return false;
+        }
+    }
+
+    g_dynamic_uart_lut[uart].uart = uart;
+
+    if (!UART_Driver_SetReceiveCallback(uart, &UART_API_ReceiveCallback, &g_dynamic_uart_lut[uart])) {
+        return false;
+    }
 
     g_dynamic_uart_lut[uart].current_state = eState_Setup;
 
     if (NULL == g_fsm_thread_id) {
-        g_fsm_thread_id = osThreadNew(UART_API_FsmThread, NULL, &g_fsm_thread_attributes);
+        g_fsm_thread_id = RTOS_API_ThreadNew(UART_API_FsmThread, NULL, &g_fsm_thread_attributes);
     }
 
     if (NULL == g_fsm_thread_id) {
         return false;
     }
 
+    osThreadFlagsSet(g_fsm_thread_id, UART_RX_FLAG(uart));
+
     return true;
 }
 
-// TODO: Revork UART_API_Send to use asynchronous sending with message queues and FSM thread + mutiple messages in buffer
+/* Queues the message on UARTs with an asynchronous transmitter, otherwise blocks until the bytes are on the wire */
 bool UART_API_Send (const eUart_t uart, const sMessage_t message, const uint32_t timeout) {
+    if (UART_Driver_IsTransmitAsync(uart)) {
+        return UART_API_SendAsync(uart, message, NULL, NULL, timeout);
+    }
+
     if (!UART_Config_IsCorrectUart(uart)) {
         TRACE_ERR("Send: Incorrect UART type [%d]\n", uart);
         
@@ -266,6 +745,94 @@ bool UART_API_Send (const eUart_t uart, const sMessage_t message, const uint32_t
     return true;
 }
 
+/* The message is copied into the transmit queue, callback (optional) fires once it has been sent */
+bool UART_API_SendAsync (const eUart_t uart, const sMessage_t message, uart_send_callback_t callback, void *context, const uint32_t timeout) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        TRACE_ERR("SendAsync: Incorrect UART type [%d]\n", uart);
+        
+        return false;
+    }
+
+    if (eState_Uninitialized == g_dynamic_uart_lut[uart].current_state) {
+        TRACE_ERR("SendAsync: UART [%d] not initialized\n", uart);
+        
+        return false;
+    }
+
+    if (!UART_Driver_IsTransmitAsync(uart)) {
+        TRACE_ERR("SendAsync: UART [%d] has no asynchronous transmitter\n", uart);
+        
+        return false;
+    }
+
+    if ((NULL == message.data) || (0 == message.size)) {
+        return false;
+    }
+
+    uint32_t start_tick = osKernelGetTickCount();
+
+    if (osOK != osMutexAcquire(g_dynamic_uart_lut[uart].mutex_send, timeout)) {
+        TRACE_ERR("SendAsync: Failed to acquire mutex for UART [%d]\n", uart);
+        
+        return false;
+    }
+
+    /* Only the mutex holder produces, so free space and done slots can only grow while waiting */
+    while ((NULL != callback) && (UART_TX_DONE_RING_CAPACITY == UART_API_TxDoneRing_GetCount(&g_dynamic_uart_lut[uart].tx_done))) {
+        if (!UART_API_WaitTransmit(uart, start_tick, timeout)) {
+            osMutexRelease(g_dynamic_uart_lut[uart].mutex_send);
+
+            return false;
+        }
+    }
+
+    /* A message larger than the ring goes out in pieces as the transmitter frees space, a timeout leaves it cut short */
+    size_t offset = 0;
+
+    while (offset < message.size) {
+        size_t free_size = 0;
+
+        if (!UART_Driver_GetTransmitFree(uart, &free_size)) {
+            osMutexRelease(g_dynamic_uart_lut[uart].mutex_send);
+
+            return false;
+        }
+
+        if (0 == free_size) {
+            if (!UART_API_WaitTransmit(uart, start_tick, timeout)) {
+                osMutexRelease(g_dynamic_uart_lut[uart].mutex_send);
+
+                return false;
+            }
+
+            continue;
+        }
+
+        size_t chunk_size = ((message.size - offset) < free_size) ? (message.size - offset) : free_size;
+
+        if (!UART_Driver_TransmitAsync(uart, (uint8_t*) &message.data[offset], chunk_size)) {
+            osMutexRelease(g_dynamic_uart_lut[uart].mutex_send);
+
+            return false;
+        }
+
+        g_dynamic_uart_lut[uart].tx_queued += chunk_size;
+        offset += chunk_size;
+    }
+
+    /* The ticket is queued only for bytes that made it into the ring, they may already be out if the line went idle */
+    if (NULL != callback) {
+        sUartTxDone_t done = {.ticket = g_dynamic_uart_lut[uart].tx_queued, .callback = callback, .context = context};
+
+        UART_API_TxDoneRing_Push(&g_dynamic_uart_lut[uart].tx_done, &done);
+        UART_Driver_NotifyTransmitIdle(uart);
+    }
+
+    osMutexRelease(g_dynamic_uart_lut[uart].mutex_send);
+
+    return true;
+}
+
 bool UART_API_Receive (const eUart_t uart, sMessage_t *message, const uint32_t timeout) {
     if (!UART_Config_IsCorrectUart(uart)) {
         TRACE_ERR("Receive: Incorrect UART type [%d]\n", uart);
@@ -294,4 +861,95 @@ bool UART_API_Receive (const eUart_t uart, sMessage_t *message, const uint32_t t
     return true;
 }
 
+/* Returns a message obtained from UART_API_Receive to the pool, safe to call from any thread */
+bool UART_API_Release (const eUart_t uart, sMessage_t *message) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        TRACE_ERR("Release: Incorrect UART type [%d]\n", uart);
+        
+        return false;
+    }
+
+    if (eState_Uninitialized == g_dynamic_uart_lut[uart].current_state) {
+        TRACE_ERR("Release: UART [%d] not initialized\n", uart);
+        
+        return false;
+    }
+
+    if ((NULL == message) || (NULL == message->data)) {
+        return false;
+    }
+
+    const size_t buffer_capacity = g_static_uart_lut[uart].buffer_capacity;
+
+    if ((message->data < g_dynamic_uart_lut[uart].pool) || (message->data >= &g_dynamic_uart_lut[uart].pool[UART_MESSAGE_POOL_SIZE * buffer_capacity])) {
+        TRACE_ERR("Release: Message is not from UART [%d] pool\n", uart);
+
+        return false;
+    }
+
+    size_t offset = (size_t) (message->data - g_dynamic_uart_lut[uart].pool);
+
+    if (0 != (offset % buffer_capacity)) {
+        return false;
+    }
+
+    uint32_t buffer_mask = 1UL << (offset / buffer_capacity);
+
+    if (0 != (atomic_fetch_or_explicit(&g_dynamic_uart_lut[uart].pool_free_mask, buffer_mask, memory_order_release) & buffer_mask)) {
+        TRACE_ERR("Release: Message released twice for UART [%d]\n", uart);
+
+        return false;
+    }
+
+    message->data = NULL;
+    message->size = 0;
+
+    osThreadFlagsSet(g_fsm_thread_id, UART_RX_FLAG(uart));
+
+    return true;
+}
+
+bool UART_API_GetFreeBuffers (const eUart_t uart, size_t *free_buffers) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    if (NULL == free_buffers) {
+        return false;
+    }
+
+    *free_buffers = (size_t) __builtin_popcount(atomic_load_explicit(&g_dynamic_uart_lut[uart].pool_free_mask, memory_order_relaxed));
+
+    return true;
+}
+
+/* Framing the UART was initialized with, the delimiter points to the UART's own copy */
+bool UART_API_GetFraming (const eUart_t uart, sUartFraming_t *framing) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    if (eState_Uninitialized == g_dynamic_uart_lut[uart].current_state) {
+        return false;
+    }
+
+    if (NULL == framing) {
+        return false;
+    }
+
+    *framing = g_static_framing_lut[uart];
+
+    return true;
+}
+
+bool UART_API_GetWakeupCount (uint32_t *wakeup_count) {
+    if (NULL == wakeup_count) {
+        return false;
+    }
+
+    *wakeup_count = g_fsm_wakeup_count;
+
+    return true;
+}
+
 #endif /* ENABLE_UART */
@@ -24,6 +24,27 @@
  * Exported types
  *********************************************************************************************************************/
 
+/* clang-format off */
+typedef enum eUartFraming {
+    eUartFraming_First = 0,
+    eUartFraming_Delimiter = eUartFraming_First,
+    eUartFraming_LengthPrefix,
+    eUartFraming_Timeout,
+    eUartFraming_Last
+} eUartFraming_t;
+
+typedef struct sUartFraming {
+    eUartFraming_t mode;
+    const char *delimiter;      // Delimiter: frame ends with these bytes, which are stripped
+    size_t delimiter_length;    // Delimiter: 0 for a NUL-terminated string, set it for binary delimiters such as "\0"
+    size_t length_size;         // LengthPrefix: little-endian payload length header of 1 to 4 bytes, which is stripped
+    uint32_t gap_timeout;       // Timeout: frame ends once the line has been quiet this long [ms]
+} sUartFraming_t;
+/* clang-format on */
+
+/* Called from interrupt context once the message has left the transmit queue */
+typedef void (*uart_send_callback_t) (void *context);
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -33,8 +54,14 @@
  *********************************************************************************************************************/
 
 bool UART_API_Init (const eUart_t uart, const eBaudrate_t baudrate, const char *delimiter);
+bool UART_API_InitFraming (const eUart_t uart, const eBaudrate_t baudrate, const sUartFraming_t *framing);
 bool UART_API_Send (const eUart_t uart, const sMessage_t message, const uint32_t timeout);
+bool UART_API_SendAsync (const eUart_t uart, const sMessage_t message, uart_send_callback_t callback, void *context, const uint32_t timeout);
 bool UART_API_Receive (const eUart_t uart, sMessage_t *message, const uint32_t timeout);
+bool UART_API_Release (const eUart_t uart, sMessage_t *message);
+bool UART_API_GetFreeBuffers (const eUart_t uart, size_t *free_buffers);
+bool UART_API_GetFraming (const eUart_t uart, sUartFraming_t *framing);
+bool UART_API_GetWakeupCount (uint32_t *wakeup_count);
 
 #endif /* ENABLE_UART */
 #endif /* SOURCE_API_UART_API_H_ */
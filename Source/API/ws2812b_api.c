@@ -6,6 +6,7 @@
 
 #if defined(ENABLE_WS2812B)
 #include "cmsis_os2.h"
+#include "rtos_api.h"
 #include "debug_api.h"
 #include "heap_api.h"
 #include "ws2812b_driver.h"
@@ -86,6 +87,7 @@ static bool WS2812B_API_Update (const eWs2812b_t device);
 static void WS2812B_API_DriverCallback (void *context, const eLedTransferState_t transfer_state);
 static bool WS2812B_API_BuildStaticAnimation (const sLedAnimationDesc_t *static_animation_data);
 static bool WS2812B_API_QueueDynamicAnimation (const sLedAnimationDesc_t *dynamic_animation_data);
+static void WS2812B_API_FreeAnimationInstance (sLedAnimationInstance_t *animation_instance);
 
 /**********************************************************************************************************************
  * Definitions of private functions
@@ -275,6 +277,10 @@ static bool WS2812B_API_QueueDynamicAnimation (const sLedAnimationDesc_t *dynami
 
             if ((NULL == rainbow_context) || (NULL == rainbow_data)) {
                 TRACE_ERR("QueueDynamicAnimation: Malloc failed for rainbow context or data\n");
+
+                Heap_API_Free(rainbow_context);
+                Heap_API_Free(rainbow_data);
+                Heap_API_Free(animation_instance);
                 
                 return false;
             }
@@ -298,6 +304,8 @@ static bool WS2812B_API_QueueDynamicAnimation (const sLedAnimationDesc_t *dynami
             animation_instance->free_animation = Animation_Rainbow_Free;
         } break;
         default: {
+            Heap_API_Free(animation_instance);
+
             return false;
         } break;
     }
@@ -308,6 +316,8 @@ static bool WS2812B_API_QueueDynamicAnimation (const sLedAnimationDesc_t *dynami
     
     if (NULL == new_animation) {
         TRACE_ERR("QueueDynamicAnimation: Malloc failed for new animation sequence\n");
+
+        WS2812B_API_FreeAnimationInstance(animation_instance);
         
         return false;
     }
@@ -318,6 +328,10 @@ static bool WS2812B_API_QueueDynamicAnimation (const sLedAnimationDesc_t *dynami
 
     if (osOK != osMutexAcquire(g_ws2812b_api_dynamic_lut[dynamic_animation_data->device].mutex, MUTEX_TIMEOUT)) {
         TRACE_ERR("QueueDynamicAnimation: Failed to acquire mutex for device [%d]\n", dynamic_animation_data->device);
+
+        WS2812B_API_FreeAnimationInstance(animation_instance);
+        Heap_API_Free(new_animation);
+
         return false;
     }
 
@@ -329,6 +343,9 @@ static bool WS2812B_API_QueueDynamicAnimation (const sLedAnimationDesc_t *dynami
             TRACE_ERR("QueueDynamicAnimation: Tail pointer is NULL while head is not NULL\n");
             
             osMutexRelease(g_ws2812b_api_dynamic_lut[dynamic_animation_data->device].mutex);
+
+            WS2812B_API_FreeAnimationInstance(animation_instance);
+            Heap_API_Free(new_animation);
             
             return false;
         }
@@ -343,6 +360,21 @@ static bool WS2812B_API_QueueDynamicAnimation (const sLedAnimationDesc_t *dynami
     return true;
 }
 
+/* Releases the animation context through its own free callback, then the instance itself */
+static void WS2812B_API_FreeAnimationInstance (sLedAnimationInstance_t *animation_instance) {
+    if (NULL == animation_instance) {
+        return;
+    }
+
+    if ((NULL != animation_instance->free_animation) && (NULL != animation_instance->context)) {
+        animation_instance->free_animation(animation_instance->context);
+    }
+
+    Heap_API_Free(animation_instance);
+
+    return;
+}
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
@@ -389,19 +421,19 @@ bool WS2812B_API_InitAll (void) {
             g_ws2812b_api_is_init = false;
         }
         
-        g_ws2812b_api_dynamic_lut[device].timer = osTimerNew(WS2812B_API_TimerCallback, osTimerPeriodic, &g_ws2812b_api_dynamic_lut[device], &g_ws2812b_api_static_lut[device].timer_attributes);
+        g_ws2812b_api_dynamic_lut[device].timer = RTOS_API_TimerNew(WS2812B_API_TimerCallback, osTimerPeriodic, &g_ws2812b_api_dynamic_lut[device], &g_ws2812b_api_static_lut[device].timer_attributes);
 
         if (NULL == g_ws2812b_api_dynamic_lut[device].timer) {
             g_ws2812b_api_is_init = false;
         }
 
-        g_ws2812b_api_dynamic_lut[device].mutex = osMutexNew(&g_ws2812b_api_static_lut[device].mutex_attributes);
+        g_ws2812b_api_dynamic_lut[device].mutex = RTOS_API_MutexNew(&g_ws2812b_api_static_lut[device].mutex_attributes);
 
         if (NULL == g_ws2812b_api_dynamic_lut[device].mutex) {
             g_ws2812b_api_is_init = false;
         }
 
-        g_ws2812b_api_dynamic_lut[device].flag = osEventFlagsNew(&g_ws2812b_api_static_lut[device].flag_attributes);
+        g_ws2812b_api_dynamic_lut[device].flag = RTOS_API_EventFlagsNew(&g_ws2812b_api_static_lut[device].flag_attributes);
 
         if (NULL == g_ws2812b_api_dynamic_lut[device].flag) {
             g_ws2812b_api_is_init = false;
@@ -533,9 +565,7 @@ bool WS2812B_API_ClearAnimations (const eWs2812b_t device) {
             return false;
         }
 
-        if ((NULL != instance->free_animation) && (NULL != instance->context)) {
-            instance->free_animation(instance->context);
-        }
+        WS2812B_API_FreeAnimationInstance(instance);
         
         g_ws2812b_api_dynamic_lut[device].head = sequence->next;
 
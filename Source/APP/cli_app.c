@@ -8,6 +8,7 @@
 
 #include <ctype.h>
 #include "cmsis_os2.h"
+#include "rtos_api.h"
 #include "default_cli_lut.h"
 #include "cmd_api.h"
 #include "uart_api.h"
@@ -56,6 +57,14 @@ static char g_response_buffer[RESPONSE_MESSAGE_CAPACITY];
 static sMessage_t g_command = {.data = NULL, .size = 0};
 static sMessage_t g_response = {.data = g_response_buffer, .size = RESPONSE_MESSAGE_CAPACITY};
 
+#if defined(ENABLE_DEFAULT_CMD)
+static sCmdIndex_t g_default_cmd_index = {0};
+#endif /* ENABLE_DEFAULT_CMD */
+
+#if defined(ENABLE_CUSTOM_CMD)
+static sCmdIndex_t g_custom_cmd_index = {0};
+#endif /* ENABLE_CUSTOM_CMD */
+
 /**********************************************************************************************************************
  * Exported variables and references
  *********************************************************************************************************************/
@@ -74,22 +83,26 @@ static void CLI_APP_Thread (void *arg) {
     while (1) {
         if (UART_API_Receive(DEBUG_UART, &g_command, osWaitForever)) {
             eErrorCode_t error_code = eErrorCode_NOTFOUND;
+
+            TRACE_SCOPE_BEGIN("cli_command");
             
             #if defined(ENABLE_DEFAULT_CMD)
-            error_code = CMD_API_FindCommand(g_command, &g_response, g_default_cmd_lut, eCliDefaultCmd_Last);
+            error_code = CMD_API_FindCommand(g_command, &g_response, &g_default_cmd_index);
             #endif /* ENABLE_DEFAULT_CMD */
 
             #if defined(ENABLE_CUSTOM_CMD)
             if (eErrorCode_NOTFOUND == error_code) {
-                error_code = CMD_API_FindCommand(g_command, &g_response, g_custom_cmd_lut, eCliCustomCmd_Last);
+                error_code = CMD_API_FindCommand(g_command, &g_response, &g_custom_cmd_index);
             }
             #endif /* ENABLE_CUSTOM_CMD */
 
+            TRACE_SCOPE_END("cli_command");
+
             if ((eErrorCode_OK != error_code) && (NULL != g_response.data)) {
-                TRACE_WRN(g_response.data);
+                TRACE_CLI_WRN("%s", g_response.data);
             }
             
-            Heap_API_Free(g_command.data);
+            UART_API_Release(DEBUG_UART, &g_command);
         }
     }
 
@@ -117,7 +130,20 @@ bool CLI_APP_Init (const eBaudrate_t baudrate) {
         return false;
     }
 
-    g_cli_thread_id = osThreadNew(CLI_APP_Thread, NULL, &g_cli_thread_attributes);
+    /* Lookup tables are hashed once here, every received command then costs one hash and one compare */
+    #if defined(ENABLE_DEFAULT_CMD)
+    if (!CMD_API_BuildIndex(&g_default_cmd_index, g_default_cmd_lut, eCliDefaultCmd_Last)) {
+        return false;
+    }
+    #endif /* ENABLE_DEFAULT_CMD */
+
+    #if defined(ENABLE_CUSTOM_CMD)
+    if (!CMD_API_BuildIndex(&g_custom_cmd_index, g_custom_cmd_lut, eCliCustomCmd_Last)) {
+        return false;
+    }
+    #endif /* ENABLE_CUSTOM_CMD */
+
+    g_cli_thread_id = RTOS_API_ThreadNew(CLI_APP_Thread, NULL, &g_cli_thread_attributes);
 
     if (NULL == g_cli_thread_id) {
         return false;
@@ -18,6 +18,7 @@
 #include "debug_api.h"
 #include "led_config.h"
 #include "colour.h"
+#include "format.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -75,25 +76,32 @@ static eErrorCode_t CLI_CMD_Led_Common (sMessage_t arguments, sMessage_t *respon
     
     eLed_t led = eLed_Last;
     size_t led_value = 0;
+    sCmdArgs_t args = {0};
 
     eErrorCode_t error = eErrorCode_OK;
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &led_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+    error = CMD_API_Helper_CheckArgCount(&args, 1, response);
 
-        return eErrorCode_ARGMANY;
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    error = CMD_API_Helper_GetArgUInt(&args, 0, &led_value, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
     }
 
     led = led_value;
 
     if (!LED_Config_IsCorrectLed(led)) {
-        snprintf(response->data, response->size, "%d: Incorrect led\n", led);
+        Format_Print(response->data, response->size, "%d: Incorrect led\n", led);
 
         return eErrorCode_INVAL;
     }
@@ -102,7 +110,7 @@ static eErrorCode_t CLI_CMD_Led_Common (sMessage_t arguments, sMessage_t *respon
     sLedCommon_t *task_data = Heap_API_Calloc(1, sizeof(sLedCommon_t));
 
     if (NULL == task_data) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
+        Format_Print(response->data, response->size, "Failed Calloc\n");
         
         return eErrorCode_NOMEM;
     }
@@ -111,14 +119,14 @@ static eErrorCode_t CLI_CMD_Led_Common (sMessage_t arguments, sMessage_t *respon
     formated_task.data = task_data;
 
     if (!LED_APP_AddTask(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
+        Format_Print(response->data, response->size, "Failed task add\n");
         
         Heap_API_Free(task_data);
 
         return eErrorCode_FAILED;
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
@@ -164,48 +172,55 @@ eErrorCode_t CLI_CMD_Led_Blink (sMessage_t arguments, sMessage_t *response) {
     size_t led_value = 0;
     size_t blink_time = 0;
     size_t blink_frequency = 0;
+    sCmdArgs_t args = {0};
     eErrorCode_t error = eErrorCode_OK;
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &led_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
-    
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &blink_time, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
-    
+    error = CMD_API_Helper_CheckArgCount(&args, 3, response);
+
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &blink_frequency, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_GetArgUInt(&args, 0, &led_value, response);
     
     if (eErrorCode_OK != error) {
         return error;
     }
-    
-    if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
 
-        return eErrorCode_ARGMANY;
+    error = CMD_API_Helper_GetArgUInt(&args, 1, &blink_time, response);
+    
+    if (eErrorCode_OK != error) {
+        return error;
     }
 
+    error = CMD_API_Helper_GetArgUInt(&args, 2, &blink_frequency, response);
+    
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+    
     led = led_value;
 
     if (!LED_Config_IsCorrectLed(led)) {
-        snprintf(response->data, response->size, "%d: Incorrect led\n", led);
+        Format_Print(response->data, response->size, "%d: Incorrect led\n", led);
 
         return eErrorCode_INVAL;
     }
 
     if (!LED_API_IsCorrectBlinkTime(blink_time)) {
-        snprintf(response->data, response->size, "%d: Incorrect blink time\n", blink_time);
+        Format_Print(response->data, response->size, "%zu: Incorrect blink time\n", blink_time);
 
         return eErrorCode_INVAL;
     }
 
     if (!LED_API_IsCorrectBlinkFrequency(blink_frequency)) {
-        snprintf(response->data, response->size, "%d: Incorrect blink frequency\n", blink_frequency);
+        Format_Print(response->data, response->size, "%zu: Incorrect blink frequency\n", blink_frequency);
 
         return eErrorCode_INVAL;
     }
@@ -214,7 +229,7 @@ eErrorCode_t CLI_CMD_Led_Blink (sMessage_t arguments, sMessage_t *response) {
     sLedBlink_t *task_data = Heap_API_Calloc(1, sizeof(sLedBlink_t));
 
     if (NULL == task_data) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
+        Format_Print(response->data, response->size, "Failed Calloc\n");
         
         return eErrorCode_NOMEM;
     }
@@ -225,14 +240,14 @@ eErrorCode_t CLI_CMD_Led_Blink (sMessage_t arguments, sMessage_t *response) {
     formated_task.data = task_data;
 
     if (!LED_APP_AddTask(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
+        Format_Print(response->data, response->size, "Failed task add\n");
         
         Heap_API_Free(task_data);
 
         return eErrorCode_CANCELED;
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
@@ -255,36 +270,43 @@ eErrorCode_t CLI_CMD_Pwm_LedSetBrightness (sMessage_t arguments, sMessage_t *res
     eLedPwm_t led = eLedPwm_Last;
     size_t led_value = 0;
     size_t duty_cycle = 0;
+    sCmdArgs_t args = {0};
     eErrorCode_t error = eErrorCode_OK;
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &led_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
-    
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &duty_cycle, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+
+    error = CMD_API_Helper_CheckArgCount(&args, 2, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+    error = CMD_API_Helper_GetArgUInt(&args, 0, &led_value, response);
 
-        return eErrorCode_ARGMANY;
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+    
+    error = CMD_API_Helper_GetArgUInt(&args, 1, &duty_cycle, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
     }
 
     led = led_value;
 
     if (!LED_Config_IsCorrectPwmLed(led)) {
-        snprintf(response->data, response->size, "%d: Incorrect led\n", led);
+        Format_Print(response->data, response->size, "%d: Incorrect led\n", led);
 
         return eErrorCode_INVAL;
     }
 
     if (!LED_API_IsCorrectDutyCycle(led, duty_cycle)) {
-        snprintf(response->data, response->size, "%d: Incorrect duty cycle\n", led);
+        Format_Print(response->data, response->size, "%zu: Incorrect duty cycle\n", duty_cycle);
 
         return eErrorCode_INVAL;
     }
@@ -293,7 +315,7 @@ eErrorCode_t CLI_CMD_Pwm_LedSetBrightness (sMessage_t arguments, sMessage_t *res
     sLedSetBrightness_t *task_data = Heap_API_Calloc(1, sizeof(sLedSetBrightness_t));
 
     if (NULL == task_data) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
+        Format_Print(response->data, response->size, "Failed Calloc\n");
         
         return eErrorCode_NOMEM;
     }
@@ -303,14 +325,14 @@ eErrorCode_t CLI_CMD_Pwm_LedSetBrightness (sMessage_t arguments, sMessage_t *res
     formated_task.data = task_data;
 
     if (!LED_APP_AddTask(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
+        Format_Print(response->data, response->size, "Failed task add\n");
         
         Heap_API_Free(task_data);
 
         return eErrorCode_FAILED;
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
@@ -332,48 +354,55 @@ eErrorCode_t CLI_CMD_Pwm_LedPulse (sMessage_t arguments, sMessage_t *response) {
     size_t led_value = 0;
     size_t pulse_time = 0;
     size_t pulse_frequency = 0;
+    sCmdArgs_t args = {0};
     eErrorCode_t error = eErrorCode_OK;
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &led_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
-    
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &pulse_time, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+
+    error = CMD_API_Helper_CheckArgCount(&args, 3, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &pulse_frequency, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_GetArgUInt(&args, 0, &led_value, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
+    
+    error = CMD_API_Helper_GetArgUInt(&args, 1, &pulse_time, response);
 
-    if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+    if (eErrorCode_OK != error) {
+        return error;
+    }
 
-        return eErrorCode_ARGMANY;
+    error = CMD_API_Helper_GetArgUInt(&args, 2, &pulse_frequency, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
     }
 
     led = led_value;
 
     if (!LED_Config_IsCorrectPwmLed(led)) {
-        snprintf(response->data, response->size, "%d: Incorrect led\n", led);
+        Format_Print(response->data, response->size, "%d: Incorrect led\n", led);
 
         return eErrorCode_INVAL;
     }
 
     if (!LED_API_IsCorrectPulseTime(pulse_time)) {
-        snprintf(response->data, response->size, "%d: Incorrect pulse time\n", led);
+        Format_Print(response->data, response->size, "%zu: Incorrect pulse time\n", pulse_time);
 
         return eErrorCode_INVAL;
     }
 
     if (!LED_API_IsCorrectPulseFrequency(pulse_frequency)) {
-        snprintf(response->data, response->size, "%d: Incorrect pulse frequency\n", led);
+        Format_Print(response->data, response->size, "%zu: Incorrect pulse frequency\n", pulse_frequency);
 
         return eErrorCode_INVAL;
     }
@@ -382,7 +411,7 @@ eErrorCode_t CLI_CMD_Pwm_LedPulse (sMessage_t arguments, sMessage_t *response) {
     sLedPulse_t *task_data = Heap_API_Calloc(1, sizeof(sLedPulse_t));
 
     if (NULL == task_data) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
+        Format_Print(response->data, response->size, "Failed Calloc\n");
         
         return eErrorCode_NOMEM;
     }
@@ -393,14 +422,14 @@ eErrorCode_t CLI_CMD_Pwm_LedPulse (sMessage_t arguments, sMessage_t *response) {
     formated_task.data = task_data;
 
     if (!LED_APP_AddTask(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
+        Format_Print(response->data, response->size, "Failed task add\n");
         
         Heap_API_Free(task_data);
 
         return eErrorCode_FAILED;
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
@@ -421,7 +450,7 @@ eErrorCode_t CLI_CMD_Motors_Stop (sMessage_t arguments, sMessage_t *response) {
     }
 
     if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+        Format_Print(response->data, response->size, "Too many arguments\n");
 
         return eErrorCode_ARGMANY;
     }
@@ -429,12 +458,12 @@ eErrorCode_t CLI_CMD_Motors_Stop (sMessage_t arguments, sMessage_t *response) {
     sMotorCommandDesc_t formated_task = {.task = eMotorTask_Stop, .data = NULL};
 
     if (!Motor_APP_AddTask(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
+        Format_Print(response->data, response->size, "Failed task add\n");
 
         return eErrorCode_FAILED;
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
@@ -457,49 +486,56 @@ eErrorCode_t CLI_CMD_Motors_Set (sMessage_t arguments, sMessage_t *response) {
     size_t speed = 0;
     size_t direction_value = 0;
     size_t mode_value = 0;
+    sCmdArgs_t args = {0};
     eErrorCode_t error = eErrorCode_OK;
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &speed, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &direction_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_CheckArgCount(&args, 3, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &mode_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_GetArgUInt(&args, 0, &speed, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+    error = CMD_API_Helper_GetArgUInt(&args, 1, &direction_value, response);
 
-        return eErrorCode_ARGMANY;
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    error = CMD_API_Helper_GetArgUInt(&args, 2, &mode_value, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
     }
 
     direction = direction_value;
     mode = mode_value;
 
     if (!Motor_API_IsCorrectSpeed(speed)) {
-        snprintf(response->data, response->size, "%d: Incorrect speed\n", speed);
+        Format_Print(response->data, response->size, "%zu: Incorrect speed\n", speed);
 
         return eErrorCode_INVAL;
     }
 
     if (!Motor_Config_IsCorrectDirection(direction)) {
-        snprintf(response->data, response->size, "%d: Incorrect motor direction\n", direction);
+        Format_Print(response->data, response->size, "%d: Incorrect motor direction\n", direction);
 
         return eErrorCode_INVAL;
     }
 
     if (!Motor_API_IsCorrectMode(mode)) {
-        snprintf(response->data, response->size, "%d: Incorrect motor mode\n", mode);
+        Format_Print(response->data, response->size, "%d: Incorrect motor mode\n", mode);
 
         return eErrorCode_INVAL;
     }
@@ -508,7 +544,7 @@ eErrorCode_t CLI_CMD_Motors_Set (sMessage_t arguments, sMessage_t *response) {
     sMotorSet_t *task_data = Heap_API_Calloc(1, sizeof(sMotorSet_t));
 
     if (NULL == task_data) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
+        Format_Print(response->data, response->size, "Failed Calloc\n");
         
         return eErrorCode_NOMEM;
     }
@@ -519,14 +555,14 @@ eErrorCode_t CLI_CMD_Motors_Set (sMessage_t arguments, sMessage_t *response) {
     formated_task.data = task_data;
 
     if (!Motor_APP_AddTask(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
+        Format_Print(response->data, response->size, "Failed task add\n");
         
         Heap_API_Free(task_data);
 
         return eErrorCode_FAILED;
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
@@ -551,47 +587,54 @@ CLI_CMD_Motors_SetTargetRpm (sMessage_t arguments, sMessage_t *response) {
     size_t motor_value = 0;
     size_t mode_value = 0;
     float target_rpm = 0.0f;
+    sCmdArgs_t args = {0};
 
     eErrorCode_t error = eErrorCode_OK;
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &motor_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &mode_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_CheckArgCount(&args, 3, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgFloat(&arguments, &target_rpm, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
-    
+    error = CMD_API_Helper_GetArgUInt(&args, 0, &motor_value, response);
+
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+    error = CMD_API_Helper_GetArgUInt(&args, 1, &mode_value, response);
 
-        return eErrorCode_ARGMANY;
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    error = CMD_API_Helper_GetArgFloat(&args, 2, &target_rpm, response);
+    
+    if (eErrorCode_OK != error) {
+        return error;
     }
 
     if (!Motor_Config_IsCorrectMotor(motor_value)) {
-        snprintf(response->data, response->size, "%d: Incorrect motor\n", motor_value);
+        Format_Print(response->data, response->size, "%zu: Incorrect motor\n", motor_value);
 
         return eErrorCode_INVAL;
     }
 
     if (!Motor_API_IsCorrectRpm(target_rpm)) {
-        snprintf(response->data, response->size, "%d: Incorrect target RPM\n", target_rpm);
+        Format_Print(response->data, response->size, "%.1f: Incorrect target RPM\n", target_rpm);
 
         return eErrorCode_INVAL;
     }
 
     if (!Motor_Config_IsCorrectMode(mode_value)) {
-        snprintf(response->data, response->size, "%d: Incorrect motor mode\n", mode_value);
+        Format_Print(response->data, response->size, "%zu: Incorrect motor mode\n", mode_value);
 
         return eErrorCode_INVAL;
     }
@@ -600,7 +643,7 @@ CLI_CMD_Motors_SetTargetRpm (sMessage_t arguments, sMessage_t *response) {
     sMotorSetRpm_t *task_data = Heap_API_Calloc(1, sizeof(sMotorSetRpm_t));
 
     if (NULL == task_data) {
-        snprintf(response->data, response->size, "Failed Calloc\n");
+        Format_Print(response->data, response->size, "Failed Calloc\n");
         
         return eErrorCode_NOMEM;
     }
@@ -611,14 +654,14 @@ CLI_CMD_Motors_SetTargetRpm (sMessage_t arguments, sMessage_t *response) {
     formated_task.data = task_data;
 
     if (!Motor_APP_AddTask(&formated_task)) {
-        snprintf(response->data, response->size, "Failed task add\n");
+        Format_Print(response->data, response->size, "Failed task add\n");
         
         Heap_API_Free(task_data);
 
         return eErrorCode_FAILED;
     }
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
@@ -639,46 +682,53 @@ eErrorCode_t CLI_CMD_Motors_SetPid (sMessage_t arguments, sMessage_t *response)
     sPID_t pid_params = {0};
     sMotor_t motor = eMotor_Last;
     size_t motor_value = 0;
+    sCmdArgs_t args = {0};
     eErrorCode_t error = eErrorCode_OK;
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &motor_value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
-    
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgFloat(&arguments, &pid_params.kp, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_CheckArgCount(&args, 5, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgFloat(&arguments, &pid_params.ki, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_GetArgUInt(&args, 0, &motor_value, response);
+    
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    error = CMD_API_Helper_GetArgFloat(&args, 1, &pid_params.kp, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgFloat(&arguments, &pid_params.kd, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_GetArgFloat(&args, 2, &pid_params.ki, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgFloat(&arguments, &pid_params.integral_limit, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_GetArgFloat(&args, 3, &pid_params.kd, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
+    error = CMD_API_Helper_GetArgFloat(&args, 4, &pid_params.integral_limit, response);
 
-        return eErrorCode_ARGMANY;
+    if (eErrorCode_OK != error) {
+        return error;
     }
 
     if (!Motor_Config_IsCorrectMotor(motor_value)) {
-        snprintf(response->data, response->size, "%d: Incorrect motor\n", motor_value);
+        Format_Print(response->data, response->size, "%zu: Incorrect motor\n", motor_value);
 
         return eErrorCode_INVAL;
     }
@@ -686,14 +736,14 @@ eErrorCode_t CLI_CMD_Motors_SetPid (sMessage_t arguments, sMessage_t *response)
     motor = motor_value;
 
     if (!Motor_API_SetPid(motor, &pid_params)) {
-        snprintf(response->data, response->size, "Failed to set PID parameters\n");
+        Format_Print(response->data, response->size, "Failed to set PID parameters\n");
 
         return eErrorCode_FAILED;
     }
 
-    TRACE_INFO("Set PID for [%d]: Kp: %ld.%04u, Ki: %ld.%04u, Kd: %ld.%04u, I limit: %ld.%04u\n", motor, FLOAT_INTEGER_PART(pid_params.kp), FLOAT_FRACTIONAL_PART(pid_params.kp, 4), FLOAT_INTEGER_PART(pid_params.ki), FLOAT_FRACTIONAL_PART(pid_params.ki, 4), FLOAT_INTEGER_PART(pid_params.kd), FLOAT_FRACTIONAL_PART(pid_params.kd, 4), FLOAT_INTEGER_PART(pid_params.integral_limit), FLOAT_FRACTIONAL_PART(pid_params.integral_limit, 4));
+    TRACE_CLI_INFO("Set PID for [%d]: Kp: %.4f, Ki: %.4f, Kd: %.4f, I limit: %.4f\n", motor, pid_params.kp, pid_params.ki, pid_params.kd, pid_params.integral_limit);
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
@@ -715,34 +765,41 @@ eErrorCode_t CLI_CMD_Led_RgbToHsv (sMessage_t arguments, sMessage_t *response) {
     size_t red = 0;
     size_t green = 0;
     size_t blue = 0;
+    sCmdArgs_t args = {0};
     eErrorCode_t error = eErrorCode_OK;
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &red, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &green, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_CheckArgCount(&args, 3, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &blue, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_GetArgUInt(&args, 0, &red, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
-    
-    if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
 
-        return eErrorCode_ARGMANY;
+    error = CMD_API_Helper_GetArgUInt(&args, 1, &green, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
     }
 
+    error = CMD_API_Helper_GetArgUInt(&args, 2, &blue, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+    
     if ((red > CHANNEL_MAX) || (green > CHANNEL_MAX) || (blue > CHANNEL_MAX)) {
-        snprintf(response->data, response->size, "Invalid RGB values\n");
+        Format_Print(response->data, response->size, "Invalid RGB values\n");
 
         return eErrorCode_INVAL;
     }
@@ -753,9 +810,9 @@ eErrorCode_t CLI_CMD_Led_RgbToHsv (sMessage_t arguments, sMessage_t *response) {
 
     Colour_RgbToHsv(rgb, &hsv);
 
-    TRACE_INFO("hue: %d, sat: %d, val: %d\n", hsv.hue, hsv.saturation, hsv.value);
+    TRACE_CLI_INFO("hue: %d, sat: %d, val: %d\n", hsv.hue, hsv.saturation, hsv.value);
 
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
@@ -776,34 +833,41 @@ eErrorCode_t CLI_CMD_Led_HsvToRgb (sMessage_t arguments, sMessage_t *response) {
     size_t hue = 0;
     size_t saturation = 0;
     size_t value = 0;
+    sCmdArgs_t args = {0};
     eErrorCode_t error = eErrorCode_OK;
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &hue, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &saturation, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_CheckArgCount(&args, 3, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
 
-    error = CMD_API_Helper_FindNextArgUInt(&arguments, &value, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+    error = CMD_API_Helper_GetArgUInt(&args, 0, &hue, response);
 
     if (eErrorCode_OK != error) {
         return error;
     }
-    
-    if (0 != arguments.size) {
-        snprintf(response->data, response->size, "Too many arguments\n");
 
-        return eErrorCode_ARGMANY;
+    error = CMD_API_Helper_GetArgUInt(&args, 1, &saturation, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
     }
 
+    error = CMD_API_Helper_GetArgUInt(&args, 2, &value, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+    
     if ((hue > CHANNEL_MAX) || (saturation > CHANNEL_MAX) || (value > CHANNEL_MAX)) {
-        snprintf(response->data, response->size, "Invalid HSV values\n");
+        Format_Print(response->data, response->size, "Invalid HSV values\n");
 
         return eErrorCode_INVAL;
     }
@@ -817,11 +881,195 @@ eErrorCode_t CLI_CMD_Led_HsvToRgb (sMessage_t arguments, sMessage_t *response) {
 
     Colour_HsvToRgb(hsv, &rgb);
 
-    TRACE_INFO("red: %d, green: %d, blue: %d\n", (rgb >> RGB_RED_SHIFT) & RGB_BYTE_MASK, (rgb >> RGB_GREEN_SHIFT) & RGB_BYTE_MASK, rgb & RGB_BYTE_MASK);
+    TRACE_CLI_INFO("red: %d, green: %d, blue: %d\n", (rgb >> RGB_RED_SHIFT) & RGB_BYTE_MASK, (rgb >> RGB_GREEN_SHIFT) & RGB_BYTE_MASK, rgb & RGB_BYTE_MASK);
     
-    snprintf(response->data, response->size, "Operation successful\n");
+    Format_Print(response->data, response->size, "Operation successful\n");
+
+    return eErrorCode_OK;
+}
+
+#if defined(ENABLE_UART_DEBUG)
+eErrorCode_t CLI_CMD_Trace_SetLevel (sMessage_t arguments, sMessage_t *response) {
+    if (NULL == response) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return eErrorCode_NULLPTR;
+    }
+
+    if (NULL == response->data) {
+        TRACE_ERR("Invalid response data pointer\n");
+
+        return eErrorCode_NULLPTR;
+    }
+
+    size_t level = eTraceLevel_Last;
+    sCmdArgs_t args = {0};
+    eErrorCode_t error = eErrorCode_OK;
+
+    error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    error = CMD_API_Helper_CheckArgCount(&args, 2, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    /* The separator after the module name was replaced by '\0', so the first slice is a C string */
+    const char *module_name = args.arg[0].data;
+
+    error = CMD_API_Helper_GetArgUInt(&args, 1, &level, response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    if (level > eTraceLevel_Last) {
+        Format_Print(response->data, response->size, "Invalid trace level\n");
+
+        return eErrorCode_INVAL;
+    }
+
+    if (!Debug_API_SetModuleLevel(module_name, (eTraceLevel_t) level)) {
+        Format_Print(response->data, response->size, "[%s]: Unknown module\n", module_name);
+
+        return eErrorCode_INVAL;
+    }
+
+    Format_Print(response->data, response->size, "Operation successful\n");
+
+    return eErrorCode_OK;
+}
+
+#if defined(DEBUG_FLIGHT_RECORDER)
+eErrorCode_t CLI_CMD_Trace_Dump (sMessage_t arguments, sMessage_t *response) {
+    if (NULL == response) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return eErrorCode_NULLPTR;
+    }
+
+    if (NULL == response->data) {
+        TRACE_ERR("Invalid response data pointer\n");
+
+        return eErrorCode_NULLPTR;
+    }
+
+    if (0 != arguments.size) {
+        Format_Print(response->data, response->size, "Too many arguments\n");
+
+        return eErrorCode_ARGMANY;
+    }
+
+    if (!Debug_API_DumpRecorder()) {
+        Format_Print(response->data, response->size, "Failed to dump flight recorder\n");
+
+        return eErrorCode_FAILED;
+    }
+
+    Format_Print(response->data, response->size, "Operation successful\n");
+
+    return eErrorCode_OK;
+}
+
+eErrorCode_t CLI_CMD_Trace_Clear (sMessage_t arguments, sMessage_t *response) {
+    if (NULL == response) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return eErrorCode_NULLPTR;
+    }
+
+    if (NULL == response->data) {
+        TRACE_ERR("Invalid response data pointer\n");
+
+        return eErrorCode_NULLPTR;
+    }
+
+    if (0 != arguments.size) {
+        Format_Print(response->data, response->size, "Too many arguments\n");
+
+        return eErrorCode_ARGMANY;
+    }
+
+    if (!Debug_API_ClearRecorder()) {
+        Format_Print(response->data, response->size, "Failed to clear flight recorder\n");
+
+        return eErrorCode_FAILED;
+    }
+
+    Format_Print(response->data, response->size, "Operation successful\n");
+
+    return eErrorCode_OK;
+}
+#endif /* DEBUG_FLIGHT_RECORDER */
+#endif /* ENABLE_UART_DEBUG */
+
+#if defined(HEAP_STATS)
+/* The report does not fit a response, it is traced line by line like the other query commands */
+eErrorCode_t CLI_CMD_Heap_Stats (sMessage_t arguments, sMessage_t *response) {
+    if (NULL == response) {
+        TRACE_ERR("Invalid data pointer\n");
+
+        return eErrorCode_NULLPTR;
+    }
+
+    if (NULL == response->data) {
+        TRACE_ERR("Invalid response data pointer\n");
+
+        return eErrorCode_NULLPTR;
+    }
+
+    if (0 != arguments.size) {
+        Format_Print(response->data, response->size, "Too many arguments\n");
+
+        return eErrorCode_ARGMANY;
+    }
+
+    sHeapStats_t stats = {0};
+
+    if (!Heap_API_GetStats(&stats)) {
+        Format_Print(response->data, response->size, "Failed to read heap stats\n");
+
+        return eErrorCode_FAILED;
+    }
+
+    TRACE_CLI_INFO("Heap: %zu B in use, peak %zu B, %lu allocations, %lu frees, %lu failed\n", stats.current_bytes, stats.peak_bytes, stats.allocations, stats.frees, stats.failed);
+
+    for (size_t bucket = 0; bucket < HEAP_STATS_HISTOGRAM_SIZE; bucket++) {
+        if ((HEAP_STATS_HISTOGRAM_SIZE - 1U) == bucket) {
+            TRACE_CLI_INFO("Size > %u B: %lu\n", (8U << (bucket - 1U)), stats.histogram[bucket]);
+        } else {
+            TRACE_CLI_INFO("Size <= %u B: %lu\n", (8U << bucket), stats.histogram[bucket]);
+        }
+    }
+
+    sHeapSite_t site = {0};
+
+    for (size_t index = 0; Heap_API_GetSite(index, &site); index++) {
+        if (0 == site.outstanding_count) {
+            continue;
+        }
+
+        TRACE_CLI_INFO("%s:%lu: %zu B in %lu blocks\n", (NULL == site.file) ? "other" : site.file, site.line, site.outstanding_bytes, site.outstanding_count);
+    }
+
+    #if defined(HEAP_API_POOL)
+    sHeapPoolStats_t pool_stats = {0};
+
+    for (eHeapPool_t pool = (eHeapPool_First + 1); pool < eHeapPool_Last; pool++) {
+        if (Heap_API_PoolGetStats(pool, &pool_stats)) {
+            TRACE_CLI_INFO("Pool %d: %zu x %zu B, used %zu, peak %zu, exhausted %lu\n", pool, pool_stats.block_count, pool_stats.block_size, pool_stats.used, pool_stats.peak_used, pool_stats.failed);
+        }
+    }
+    #endif /* HEAP_API_POOL */
+
+    Format_Print(response->data, response->size, "Operation successful\n");
 
     return eErrorCode_OK;
 }
+#endif /* HEAP_STATS */
 
 #endif /* ENABLE_DEFAULT_CMD */
@@ -51,5 +51,17 @@ eErrorCode_t CLI_CMD_Motors_SetPid (sMessage_t arguments, sMessage_t *response);
 eErrorCode_t CLI_CMD_Led_RgbToHsv (sMessage_t arguments, sMessage_t *response);
 eErrorCode_t CLI_CMD_Led_HsvToRgb (sMessage_t arguments, sMessage_t *response);
 
+#if defined(ENABLE_UART_DEBUG)
+eErrorCode_t CLI_CMD_Trace_SetLevel (sMessage_t arguments, sMessage_t *response);
+#if defined(DEBUG_FLIGHT_RECORDER)
+eErrorCode_t CLI_CMD_Trace_Dump (sMessage_t arguments, sMessage_t *response);
+eErrorCode_t CLI_CMD_Trace_Clear (sMessage_t arguments, sMessage_t *response);
+#endif /* DEBUG_FLIGHT_RECORDER */
+#endif /* ENABLE_UART_DEBUG */
+
+#if defined(HEAP_STATS)
+eErrorCode_t CLI_CMD_Heap_Stats (sMessage_t arguments, sMessage_t *response);
+#endif /* HEAP_STATS */
+
 #endif /* ENABLE_DEFAULT_CMD */
 #endif /* SOURCE_APP_CLI_CMD_H_ */
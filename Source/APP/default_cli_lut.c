@@ -102,7 +102,33 @@ sCmdDesc_t g_default_cmd_lut[eCliDefaultCmd_Last] = {
         DEFINE_CMD("hsv:"),
         .handler = CLI_CMD_Led_HsvToRgb
         /* e. g. hsv:<h>, <s>, <v> */
-    }
+    },
+    #if defined(ENABLE_UART_DEBUG)
+    [eCliDefaultCmd_Trace_SetLevel] = {
+        DEFINE_CMD("trace_level:"),
+        .handler = CLI_CMD_Trace_SetLevel
+        /* e. g. trace_level:<module | all>, <level: 0 info, 1 warning, 2 error, 3 off> */
+    },
+    #if defined(DEBUG_FLIGHT_RECORDER)
+    [eCliDefaultCmd_Trace_Dump] = {
+        DEFINE_CMD("trace_dump:"),
+        .handler = CLI_CMD_Trace_Dump
+        /* e. g. trace_dump: */
+    },
+    [eCliDefaultCmd_Trace_Clear] = {
+        DEFINE_CMD("trace_clear:"),
+        .handler = CLI_CMD_Trace_Clear
+        /* e. g. trace_clear: */
+    },
+    #endif /* DEBUG_FLIGHT_RECORDER */
+    #endif /* ENABLE_UART_DEBUG */
+    #if defined(HEAP_STATS)
+    [eCliDefaultCmd_Heap_Stats] = {
+        DEFINE_CMD("heap_stats:"),
+        .handler = CLI_CMD_Heap_Stats
+        /* e. g. heap_stats: */
+    },
+    #endif /* HEAP_STATS */
     // TODO: Add VL53L0X calibration
 };
 /* clang-format on */
@@ -44,6 +44,18 @@ typedef enum eCliDefaultCmd {
     
     eCliDefaultCmd_RgbToHsv,
     eCliDefaultCmd_HsvToRgb,
+
+    #if defined(ENABLE_UART_DEBUG)
+    eCliDefaultCmd_Trace_SetLevel,
+    #if defined(DEBUG_FLIGHT_RECORDER)
+    eCliDefaultCmd_Trace_Dump,
+    eCliDefaultCmd_Trace_Clear,
+    #endif /* DEBUG_FLIGHT_RECORDER */
+    #endif /* ENABLE_UART_DEBUG */
+
+    #if defined(HEAP_STATS)
+    eCliDefaultCmd_Heap_Stats,
+    #endif /* HEAP_STATS */
     eCliDefaultCmd_Last
 } eCliDefaultCmd_t;
 /* clang-format on */
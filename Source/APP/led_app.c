@@ -8,6 +8,7 @@
 
 #include <stddef.h>
 #include "cmsis_os2.h"
+#include "rtos_api.h"
 #include "cli_app.h"
 #include "debug_api.h"
 #include "heap_api.h"
@@ -317,13 +318,13 @@ bool LED_APP_Init (void) {
         return false;
     }
 
-    g_led_message_queue_id = osMessageQueueNew(LED_COMMAND_MESSAGE_CAPACITY, sizeof(sLedCommandDesc_t), &g_led_message_queue_attributes);
+    g_led_message_queue_id = RTOS_API_MessageQueueNew(LED_COMMAND_MESSAGE_CAPACITY, sizeof(sLedCommandDesc_t), &g_led_message_queue_attributes);
     
     if (NULL == g_led_message_queue_id) {
         return false;
     }
 
-    g_led_thread_id = osThreadNew(LED_APP_Thread, NULL, &g_led_thread_attributes);
+    g_led_thread_id = RTOS_API_ThreadNew(LED_APP_Thread, NULL, &g_led_thread_attributes);
 
     if (NULL == g_led_thread_id) {
         return false;
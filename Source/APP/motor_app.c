@@ -8,11 +8,11 @@
 
 #include <stddef.h>
 #include "cmsis_os2.h"
+#include "rtos_api.h"
 #include "cli_app.h"
 #include "debug_api.h"
 #include "motor_api.h"
 #include "heap_api.h"
-#include "float_parts.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -112,7 +112,7 @@ static void Motor_APP_Thread (void *arg) {
                     break;
                 }
 
-                TRACE_INFO("Motors @ Speed [%d.%03u], Dir [%d], Mode [%d]\n", FLOAT_INTEGER_PART(arguments->speed), FLOAT_FRACTIONAL_PART(arguments->speed, 3), arguments->direction, arguments->mode);
+                TRACE_INFO("Motors @ Speed [%.3f], Dir [%d], Mode [%d]\n", arguments->speed, arguments->direction, arguments->mode);
 
                 Heap_API_Free(arguments);    
             } break;
@@ -200,13 +200,13 @@ bool Motor_APP_Init (void) {
         return false;
     }
 
-    g_motor_message_queue_id = osMessageQueueNew(MOTOR_MESSAGE_QUEUE_CAPACITY, sizeof(sMotorCommandDesc_t), &g_motor_message_queue_attributes);
+    g_motor_message_queue_id = RTOS_API_MessageQueueNew(MOTOR_MESSAGE_QUEUE_CAPACITY, sizeof(sMotorCommandDesc_t), &g_motor_message_queue_attributes);
 
     if (NULL == g_motor_message_queue_id) {
         return false;
     }
 
-    g_motor_thread_id = osThreadNew(Motor_APP_Thread, NULL, &g_motor_thread_attributes);
+    g_motor_thread_id = RTOS_API_ThreadNew(Motor_APP_Thread, NULL, &g_motor_thread_attributes);
 
     if (NULL == g_motor_thread_id) {
         return false;
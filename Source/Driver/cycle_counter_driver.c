@@ -0,0 +1,68 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "cycle_counter_driver.h"
+
+#if defined(ENABLE_CYCLE_COUNTER)
+#include "stm32f4xx.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+static bool g_is_initialized = false;
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/* DWT CYCCNT counts core clock cycles and wraps every 2^32 cycles (~42.9 s at 100 MHz) */
+bool Cycle_Counter_Driver_Init (void) {
+    if (g_is_initialized) {
+        return true;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    if (0 != (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk)) {
+        return false;
+    }
+
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    g_is_initialized = true;
+
+    return g_is_initialized;
+}
+
+uint32_t Cycle_Counter_Driver_GetCycles (void) {
+    return DWT->CYCCNT;
+}
+
+#endif /* ENABLE_CYCLE_COUNTER */
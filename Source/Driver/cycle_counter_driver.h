@@ -1,28 +1,19 @@
-#ifndef FRAMEWORK_SOURCE_UTILITY_FLOAT_PARTS_H_
-#define FRAMEWORK_SOURCE_UTILITY_FLOAT_PARTS_H_
+#ifndef SOURCE_DRIVER_CYCLE_COUNTER_DRIVER_H_
+#define SOURCE_DRIVER_CYCLE_COUNTER_DRIVER_H_
 /**********************************************************************************************************************
  * Includes
  *********************************************************************************************************************/
 
-#include <math.h>
-#include <stdlib.h>
+#include "framework_config.h"
+
+#if defined(ENABLE_CYCLE_COUNTER)
+#include <stdbool.h>
+#include <stdint.h>
 
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
 
-#define POW10_0 1
-#define POW10_1 10
-#define POW10_2 100
-#define POW10_3 1000
-#define POW10_4 10000
-#define POW10_5 100000
-
-#define POW10(n) POW10_##n
-
-#define FLOAT_INTEGER_PART(float_value) ((int32_t)(float_value))
-#define FLOAT_FRACTIONAL_PART(float_value, precision) (labs(((int32_t)((float_value) * POW10(precision))) % POW10(precision)))
-
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
@@ -35,4 +26,8 @@
  * Prototypes of exported functions
  *********************************************************************************************************************/
 
-#endif /* FRAMEWORK_SOURCE_UTILITY_FLOAT_PARTS_H_ */
+bool Cycle_Counter_Driver_Init (void);
+uint32_t Cycle_Counter_Driver_GetCycles (void);
+
+#endif /* ENABLE_CYCLE_COUNTER */
+#endif /* SOURCE_DRIVER_CYCLE_COUNTER_DRIVER_H_ */
@@ -679,4 +679,22 @@ bool DMA_Driver_DisableItAll (const eDma_t stream) {
     return true;
 }
 
+bool DMA_Driver_GetDataLength (const eDma_t stream, size_t *length) {
+    if (!DMA_Config_IsCorrectDma(stream)) {
+        return false;
+    }
+
+    if (!g_dynamic_dma_lut[stream].is_init) {
+        return false;
+    }
+
+    if (NULL == length) {
+        return false;
+    }
+
+    *length = LL_DMA_GetDataLength(g_dma_desc_lut[stream].dma, g_dma_desc_lut[stream].stream);
+
+    return true;
+}
+
 #endif /* ENABLE_DMA */
@@ -56,6 +56,7 @@ bool DMA_Driver_EnableIt (const eDma_t stream, const eDma_Flags_t flag);
 bool DMA_Driver_EnableItAll (const eDma_t stream);
 bool DMA_Driver_DisableIt (const eDma_t stream, const eDma_Flags_t flag);
 bool DMA_Driver_DisableItAll (const eDma_t stream);
+bool DMA_Driver_GetDataLength (const eDma_t stream, size_t *length);
 
 #endif /* ENABLE_DMA */
 #endif /* SOURCE_DRIVER_DMA_DRIVER_H_ */
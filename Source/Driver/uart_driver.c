@@ -5,16 +5,73 @@
 #include "uart_driver.h"
 
 #if defined(ENABLE_UART)
-#include "ring_buffer.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 
+#define UART_RX_RING_BUFFER_POLICY eRingBufferPolicy_DropNewest
+/* DMA keeps writing into the ring storage regardless of the reader, so unread bytes are overwritten when it falls behind */
+#define UART_DMA_RX_RING_BUFFER_POLICY eRingBufferPolicy_OverwriteOldest
+#define UART_TX_RING_BUFFER_POLICY eRingBufferPolicy_Reject
+
+/* Combined transmitter and receiver clock mismatch the receiver sampling still tolerates */
+#define UART_BAUDRATE_MAX_ERROR_PERMILLE 20U
+
+#if defined(UART1) && defined(UART_1_RX_DMA_STREAM) && defined(ENABLE_DMA)
+#define UART_1_RX_RING_BUFFER_POLICY UART_DMA_RX_RING_BUFFER_POLICY
+#else
+#define UART_1_RX_RING_BUFFER_POLICY UART_RX_RING_BUFFER_POLICY
+#endif /* UART1 && UART_1_RX_DMA_STREAM && ENABLE_DMA */
+
+#if defined(UART2) && defined(UART_2_RX_DMA_STREAM) && defined(ENABLE_DMA)
+#define UART_2_RX_RING_BUFFER_POLICY UART_DMA_RX_RING_BUFFER_POLICY
+#else
+#define UART_2_RX_RING_BUFFER_POLICY UART_RX_RING_BUFFER_POLICY
+#endif /* UART2 && UART_2_RX_DMA_STREAM && ENABLE_DMA */
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
 
+typedef struct sUartRxCallbackDesc {
+    uart_rx_callback_t callback;
+    void *context;
+} sUartRxCallbackDesc_t;
+
+#if defined(UART_DMA_RX)
+/* clang-format off */
+typedef struct sUartDmaRxDesc {
+    bool is_enabled;
+    eDma_t stream;
+    eUart_t uart;
+    size_t position;
+} sUartDmaRxDesc_t;
+/* clang-format on */
+#endif /* UART_DMA_RX */
+
+#if defined(UART_TX_RING)
+/* clang-format off */
+typedef struct sUartTxDesc {
+    bool is_busy;
+    size_t transmitted;
+    uart_tx_callback_t callback;
+    void *callback_context;
+} sUartTxDesc_t;
+/* clang-format on */
+#endif /* UART_TX_RING */
+
+#if defined(UART_DMA_TX)
+/* clang-format off */
+typedef struct sUartDmaTxDesc {
+    bool is_enabled;
+    eDma_t stream;
+    eUart_t uart;
+    size_t in_flight;
+} sUartDmaTxDesc_t;
+/* clang-format on */
+#endif /* UART_DMA_TX */
+
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
@@ -23,8 +80,77 @@
  * Private variables
  *********************************************************************************************************************/
 
+#if defined(UART1) && defined(UART_1_RING_BUFFER_CAPACITY)
+RING_BUFFER_DEFINE(g_uart_1_ring_buffer, UART_1_RING_BUFFER_CAPACITY, UART_1_RX_RING_BUFFER_POLICY)
+#endif /* UART1 && UART_1_RING_BUFFER_CAPACITY */
+
+#if defined(UART2) && defined(UART_2_RING_BUFFER_CAPACITY)
+RING_BUFFER_DEFINE(g_uart_2_ring_buffer, UART_2_RING_BUFFER_CAPACITY, UART_2_RX_RING_BUFFER_POLICY)
+#endif /* UART2 && UART_2_RING_BUFFER_CAPACITY */
+
 static sUartDesc_t g_uart_lut[eUart_Last] = {0};
-static RingBuffer_Handle g_ring_buffer[eUart_Last] = {NULL};
+static sUartRxCallbackDesc_t g_rx_callback_lut[eUart_Last] = {0};
+static sUartErrorStats_t g_error_lut[eUart_Last] = {0};
+
+/* UARTs without a static ring buffer fall back to a heap allocated one sized by ring_buffer_capacity */
+static RingBuffer_Handle g_ring_buffer[eUart_Last] = {
+    #if defined(UART1) && defined(UART_1_RING_BUFFER_CAPACITY)
+    [UART1] = &g_uart_1_ring_buffer,
+    #endif /* UART1 && UART_1_RING_BUFFER_CAPACITY */
+
+    #if defined(UART2) && defined(UART_2_RING_BUFFER_CAPACITY)
+    [UART2] = &g_uart_2_ring_buffer,
+    #endif /* UART2 && UART_2_RING_BUFFER_CAPACITY */
+};
+
+#if defined(UART_DMA_RX)
+/* Circular DMA streams writing straight into the RX ring storage, position is the last write index published */
+static sUartDmaRxDesc_t g_dma_rx_lut[eUart_Last] = {
+    #if defined(UART1) && defined(UART_1_RX_DMA_STREAM)
+    [UART1] = {.is_enabled = true, .stream = UART_1_RX_DMA_STREAM, .uart = UART1},
+    #endif /* UART1 && UART_1_RX_DMA_STREAM */
+
+    #if defined(UART2) && defined(UART_2_RX_DMA_STREAM)
+    [UART2] = {.is_enabled = true, .stream = UART_2_RX_DMA_STREAM, .uart = UART2},
+    #endif /* UART2 && UART_2_RX_DMA_STREAM */
+};
+#endif /* UART_DMA_RX */
+
+#if defined(UART_TX_RING)
+#if defined(UART1) && defined(UART_1_TX_RING_BUFFER_CAPACITY)
+RING_BUFFER_DEFINE(g_uart_1_tx_ring_buffer, UART_1_TX_RING_BUFFER_CAPACITY, UART_TX_RING_BUFFER_POLICY)
+#endif /* UART1 && UART_1_TX_RING_BUFFER_CAPACITY */
+
+#if defined(UART2) && defined(UART_2_TX_RING_BUFFER_CAPACITY)
+RING_BUFFER_DEFINE(g_uart_2_tx_ring_buffer, UART_2_TX_RING_BUFFER_CAPACITY, UART_TX_RING_BUFFER_POLICY)
+#endif /* UART2 && UART_2_TX_RING_BUFFER_CAPACITY */
+
+/* UARTs with a TX ring transmit asynchronously, drained by DMA when a stream is configured and by TXE/TC otherwise */
+static RingBuffer_Handle g_tx_ring_buffer[eUart_Last] = {
+    #if defined(UART1) && defined(UART_1_TX_RING_BUFFER_CAPACITY)
+    [UART1] = &g_uart_1_tx_ring_buffer,
+    #endif /* UART1 && UART_1_TX_RING_BUFFER_CAPACITY */
+
+    #if defined(UART2) && defined(UART_2_TX_RING_BUFFER_CAPACITY)
+    [UART2] = &g_uart_2_tx_ring_buffer,
+    #endif /* UART2 && UART_2_TX_RING_BUFFER_CAPACITY */
+};
+
+static sUartTxDesc_t g_tx_lut[eUart_Last] = {0};
+#endif /* UART_TX_RING */
+
+#if defined(UART_DMA_TX)
+/* Normal mode DMA streams sending the TX ring one contiguous span at a time, in_flight is the span being sent */
+static sUartDmaTxDesc_t g_dma_tx_lut[eUart_Last] = {
+    #if defined(UART1) && defined(UART_1_TX_DMA_STREAM) && defined(UART_1_TX_RING_BUFFER_CAPACITY)
+    [UART1] = {.is_enabled = true, .stream = UART_1_TX_DMA_STREAM, .uart = UART1},
+    #endif /* UART1 && UART_1_TX_DMA_STREAM && UART_1_TX_RING_BUFFER_CAPACITY */
+
+    #if defined(UART2) && defined(UART_2_TX_DMA_STREAM) && defined(UART_2_TX_RING_BUFFER_CAPACITY)
+    [UART2] = {.is_enabled = true, .stream = UART_2_TX_DMA_STREAM, .uart = UART2},
+    #endif /* UART2 && UART_2_TX_DMA_STREAM && UART_2_TX_RING_BUFFER_CAPACITY */
+};
+#endif /* UART_DMA_TX */
 
 /**********************************************************************************************************************
  * Exported variables and references
@@ -34,7 +160,30 @@ static RingBuffer_Handle g_ring_buffer[eUart_Last] = {NULL};
  * Prototypes of private functions
  *********************************************************************************************************************/
 
+static uint32_t UART_Driver_GetClock (const eUart_t uart);
+static bool UART_Driver_IsRtsEnabled (const eUart_t uart);
+static void UART_Driver_ResumeReceive (const eUart_t uart);
+static bool UART_Driver_AccountErrors (const eUart_t uart);
+static void UART_Driver_NotifyReceive (const eUart_t uart);
 static void UARTx_ISRHandler (const eUart_t uart);
+#if defined(UART_DMA_RX)
+static bool UART_Driver_IsDmaRx (const eUart_t uart);
+static void UART_Driver_DmaRxUpdate (const eUart_t uart);
+static void UART_Driver_DmaRxISRHandler (void *context, const eDma_Flags_t flag);
+static bool UART_Driver_DmaRxInit (const eUart_t uart);
+#endif /* UART_DMA_RX */
+#if defined(UART_TX_RING)
+static void UART_Driver_NotifyTransmit (const eUart_t uart);
+static void UART_Driver_TransmitStart (const eUart_t uart);
+static void UART_Driver_TxeISRHandler (const eUart_t uart);
+static void UART_Driver_TcISRHandler (const eUart_t uart);
+#endif /* UART_TX_RING */
+#if defined(UART_DMA_TX)
+static bool UART_Driver_IsDmaTx (const eUart_t uart);
+static void UART_Driver_DmaTxStart (const eUart_t uart);
+static void UART_Driver_DmaTxISRHandler (void *context, const eDma_Flags_t flag);
+static bool UART_Driver_DmaTxInit (const eUart_t uart);
+#endif /* UART_DMA_TX */
 void USART1_IRQHandler (void);
 void USART2_IRQHandler (void);
 
@@ -42,6 +191,346 @@ void USART2_IRQHandler (void);
  * Definitions of private functions
  *********************************************************************************************************************/
 
+#if defined(UART_DMA_RX)
+static bool UART_Driver_IsDmaRx (const eUart_t uart) {
+    return g_dma_rx_lut[uart].is_enabled;
+}
+
+/* Publishes everything DMA wrote since the last call, called from the IDLE, HT and TC interrupts */
+static void UART_Driver_DmaRxUpdate (const eUart_t uart) {
+    sRingBufferSpan_t storage = {0};
+    size_t remaining = 0;
+
+    if (!Ring_Buffer_GetStorage(g_ring_buffer[uart], &storage)) {
+        return;
+    }
+
+    if (!DMA_Driver_GetDataLength(g_dma_rx_lut[uart].stream, &remaining)) {
+        return;
+    }
+
+    // USART and DMA interrupts may preempt each other, both publish through the same ring head
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    size_t position = (storage.size - remaining) & (storage.size - 1);
+    size_t received = (position - g_dma_rx_lut[uart].position) & (storage.size - 1);
+
+    if (0 != received) {
+        Ring_Buffer_Commit(g_ring_buffer[uart], received);
+        g_dma_rx_lut[uart].position = position;
+    }
+
+    __set_PRIMASK(primask);
+
+    return;
+}
+
+static void UART_Driver_DmaRxISRHandler (void *context, const eDma_Flags_t flag) {
+    if (NULL == context) {
+        return;
+    }
+
+    if ((flag < eDma_Flags_First) || (flag >= eDma_Flags_Last)) {
+        return;
+    }
+
+    sUartDmaRxDesc_t *dma_rx = (sUartDmaRxDesc_t*) context;
+
+    DMA_Driver_ClearFlag(dma_rx->stream, flag);
+
+    if (eDma_Flags_TE == flag) {
+        return;
+    }
+
+    UART_Driver_DmaRxUpdate(dma_rx->uart);
+    UART_Driver_NotifyReceive(dma_rx->uart);
+
+    return;
+}
+
+static bool UART_Driver_DmaRxInit (const eUart_t uart) {
+    sRingBufferSpan_t storage = {0};
+
+    if (!Ring_Buffer_GetStorage(g_ring_buffer[uart], &storage)) {
+        return false;
+    }
+
+    if (storage.size > UINT16_MAX) {
+        return false;
+    }
+
+    sDmaInit_t dma_init_struct = {
+        .stream = g_dma_rx_lut[uart].stream,
+        .periph_or_src_addr = (uint32_t*) LL_USART_DMA_GetRegAddr(g_uart_lut[uart].periph),
+        .mem_or_dest_addr = (uint32_t*) storage.data,
+        .data_buffer_size = (uint16_t) storage.size,
+        .isr_callback = &UART_Driver_DmaRxISRHandler,
+        .isr_callback_context = &g_dma_rx_lut[uart]
+    };
+
+    if (!DMA_Driver_Init(&dma_init_struct)) {
+        return false;
+    }
+
+    if (!DMA_Driver_ConfigureStream(g_dma_rx_lut[uart].stream, dma_init_struct.periph_or_src_addr, dma_init_struct.mem_or_dest_addr, storage.size)) {
+        return false;
+    }
+
+    g_dma_rx_lut[uart].position = 0;
+
+    LL_USART_EnableDMAReq_RX(g_uart_lut[uart].periph);
+
+    return DMA_Driver_EnableStream(g_dma_rx_lut[uart].stream);
+}
+#endif /* UART_DMA_RX */
+
+#if defined(UART_TX_RING)
+static void UART_Driver_NotifyTransmit (const eUart_t uart) {
+    if (NULL == g_tx_lut[uart].callback) {
+        return;
+    }
+
+    g_tx_lut[uart].callback(g_tx_lut[uart].callback_context, g_tx_lut[uart].transmitted);
+
+    return;
+}
+
+/* Must run with interrupts masked or from the UART's own transmit interrupt */
+static void UART_Driver_TransmitStart (const eUart_t uart) {
+    #if defined(UART_DMA_TX)
+    if (UART_Driver_IsDmaTx(uart)) {
+        UART_Driver_DmaTxStart(uart);
+
+        return;
+    }
+    #endif /* UART_DMA_TX */
+
+    if (0 == Ring_Buffer_GetCount(g_tx_ring_buffer[uart])) {
+        g_tx_lut[uart].is_busy = false;
+
+        return;
+    }
+
+    g_tx_lut[uart].is_busy = true;
+
+    LL_USART_EnableIT_TXE(g_uart_lut[uart].periph);
+
+    return;
+}
+
+static void UART_Driver_TxeISRHandler (const eUart_t uart) {
+    uint8_t data = 0;
+
+    // The last byte is still in the shift register, TC tells when the line is actually done
+    if (!Ring_Buffer_Pop(g_tx_ring_buffer[uart], &data)) {
+        LL_USART_DisableIT_TXE(g_uart_lut[uart].periph);
+        LL_USART_EnableIT_TC(g_uart_lut[uart].periph);
+
+        return;
+    }
+
+    LL_USART_TransmitData8(g_uart_lut[uart].periph, data);
+
+    g_tx_lut[uart].transmitted++;
+
+    /* Long messages notify once half the ring is free, so a waiting sender refills before the line runs dry */
+    sRingBufferSpan_t storage = {0};
+
+    if (Ring_Buffer_GetStorage(g_tx_ring_buffer[uart], &storage) && ((storage.size / 2) == Ring_Buffer_GetCount(g_tx_ring_buffer[uart]))) {
+        UART_Driver_NotifyTransmit(uart);
+    }
+
+    return;
+}
+
+static void UART_Driver_TcISRHandler (const eUart_t uart) {
+    LL_USART_ClearFlag_TC(g_uart_lut[uart].periph);
+    LL_USART_DisableIT_TC(g_uart_lut[uart].periph);
+
+    // Bytes queued while draining did not restart transmission because the UART was still busy
+    UART_Driver_TransmitStart(uart);
+
+    UART_Driver_NotifyTransmit(uart);
+
+    return;
+}
+#endif /* UART_TX_RING */
+
+#if defined(UART_DMA_TX)
+static bool UART_Driver_IsDmaTx (const eUart_t uart) {
+    return g_dma_tx_lut[uart].is_enabled;
+}
+
+/* Must run with interrupts masked or from the stream's own interrupt */
+static void UART_Driver_DmaTxStart (const eUart_t uart) {
+    sRingBufferSpan_t first = {0};
+    sRingBufferSpan_t second = {0};
+
+    if (!Ring_Buffer_Peek(g_tx_ring_buffer[uart], &first, &second)) {
+        g_tx_lut[uart].is_busy = false;
+
+        return;
+    }
+
+    if (!DMA_Driver_ConfigureStream(g_dma_tx_lut[uart].stream, (uint32_t*) first.data, NULL, first.size)) {
+        g_tx_lut[uart].is_busy = false;
+
+        return;
+    }
+
+    g_dma_tx_lut[uart].in_flight = first.size;
+    g_tx_lut[uart].is_busy = true;
+
+    DMA_Driver_ClearAllFlags(g_dma_tx_lut[uart].stream);
+    DMA_Driver_EnableStream(g_dma_tx_lut[uart].stream);
+
+    return;
+}
+
+static void UART_Driver_DmaTxISRHandler (void *context, const eDma_Flags_t flag) {
+    if (NULL == context) {
+        return;
+    }
+
+    if ((flag < eDma_Flags_First) || (flag >= eDma_Flags_Last)) {
+        return;
+    }
+
+    sUartDmaTxDesc_t *dma_tx = (sUartDmaTxDesc_t*) context;
+
+    DMA_Driver_ClearFlag(dma_tx->stream, flag);
+
+    if (eDma_Flags_HT == flag) {
+        return;
+    }
+
+    // A transfer error drops the span, so one bad transfer does not stall the queue
+    Ring_Buffer_Consume(g_tx_ring_buffer[dma_tx->uart], dma_tx->in_flight);
+
+    g_tx_lut[dma_tx->uart].transmitted += dma_tx->in_flight;
+    dma_tx->in_flight = 0;
+
+    UART_Driver_NotifyTransmit(dma_tx->uart);
+
+    UART_Driver_DmaTxStart(dma_tx->uart);
+
+    return;
+}
+
+static bool UART_Driver_DmaTxInit (const eUart_t uart) {
+    sRingBufferSpan_t storage = {0};
+
+    if (!Ring_Buffer_GetStorage(g_tx_ring_buffer[uart], &storage)) {
+        return false;
+    }
+
+    if (storage.size > UINT16_MAX) {
+        return false;
+    }
+
+    sDmaInit_t dma_init_struct = {
+        .stream = g_dma_tx_lut[uart].stream,
+        .periph_or_src_addr = (uint32_t*) LL_USART_DMA_GetRegAddr(g_uart_lut[uart].periph),
+        .mem_or_dest_addr = (uint32_t*) storage.data,
+        .data_buffer_size = (uint16_t) storage.size,
+        .isr_callback = &UART_Driver_DmaTxISRHandler,
+        .isr_callback_context = &g_dma_tx_lut[uart]
+    };
+
+    if (!DMA_Driver_Init(&dma_init_struct)) {
+        return false;
+    }
+
+    g_dma_tx_lut[uart].in_flight = 0;
+
+    LL_USART_EnableDMAReq_TX(g_uart_lut[uart].periph);
+
+    return true;
+}
+#endif /* UART_DMA_TX */
+
+/* Same bus split as LL_USART_Init, USART1 and USART6 are clocked from APB2 */
+static uint32_t UART_Driver_GetClock (const eUart_t uart) {
+    LL_RCC_ClocksTypeDef clocks = {0};
+
+    LL_RCC_GetSystemClocksFreq(&clocks);
+
+    #if defined(USART6)
+    if (USART6 == g_uart_lut[uart].periph) {
+        return clocks.PCLK2_Frequency;
+    }
+    #endif /* USART6 */
+
+    return (USART1 == g_uart_lut[uart].periph) ? clocks.PCLK2_Frequency : clocks.PCLK1_Frequency;
+}
+
+static bool UART_Driver_IsRtsEnabled (const eUart_t uart) {
+    return (0 != (g_uart_lut[uart].flow_control & LL_USART_HWCONTROL_RTS));
+}
+
+/* Re-arms RXNE after the reader freed space, the byte held in DR is read right away and RTS is asserted again */
+static void UART_Driver_ResumeReceive (const eUart_t uart) {
+    if (!UART_Driver_IsRtsEnabled(uart)) {
+        return;
+    }
+
+    #if defined(UART_DMA_RX)
+    if (UART_Driver_IsDmaRx(uart)) {
+        return;
+    }
+    #endif /* UART_DMA_RX */
+
+    // CR1 is also modified from the interrupt, so the read-modify-write must not be preempted
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!LL_USART_IsEnabledIT_RXNE(g_uart_lut[uart].periph)) {
+        LL_USART_EnableIT_RXNE(g_uart_lut[uart].periph);
+    }
+
+    __set_PRIMASK(primask);
+
+    return;
+}
+
+/* Must run before DR is read, the SR read followed by the DR read clears every error flag */
+static bool UART_Driver_AccountErrors (const eUart_t uart) {
+    bool is_error = false;
+
+    if (LL_USART_IsActiveFlag_ORE(g_uart_lut[uart].periph)) {
+        g_error_lut[uart].overrun++;
+        is_error = true;
+    }
+
+    if (LL_USART_IsActiveFlag_FE(g_uart_lut[uart].periph)) {
+        g_error_lut[uart].framing++;
+        is_error = true;
+    }
+
+    if (LL_USART_IsActiveFlag_NE(g_uart_lut[uart].periph)) {
+        g_error_lut[uart].noise++;
+        is_error = true;
+    }
+
+    if (LL_USART_IsActiveFlag_PE(g_uart_lut[uart].periph)) {
+        g_error_lut[uart].parity++;
+        is_error = true;
+    }
+
+    return is_error;
+}
+
+static void UART_Driver_NotifyReceive (const eUart_t uart) {
+    if (NULL == g_rx_callback_lut[uart].callback) {
+        return;
+    }
+
+    g_rx_callback_lut[uart].callback(g_rx_callback_lut[uart].context);
+
+    return;
+}
+
 static void UARTx_ISRHandler (const eUart_t uart) {
     if (!UART_Config_IsCorrectUart(uart)) {
         return;
@@ -50,13 +539,55 @@ static void UARTx_ISRHandler (const eUart_t uart) {
     if (!LL_USART_IsEnabled(g_uart_lut[uart].periph)) {
         return;
     }
-    
-    if (!LL_USART_IsActiveFlag_RXNE(g_uart_lut[uart].periph)) {
-        return;
+
+    // With DMA reception RXNE is serviced by the stream, reading DR here would steal a byte from it
+    if (LL_USART_IsEnabledIT_RXNE(g_uart_lut[uart].periph) && LL_USART_IsActiveFlag_RXNE(g_uart_lut[uart].periph)) {
+        if (UART_Driver_IsRtsEnabled(uart) && Ring_Buffer_IsFull(g_ring_buffer[uart])) {
+            // Leaving the byte in DR keeps RTS deasserted, so the sender pauses until the reader frees space
+            LL_USART_DisableIT_RXNE(g_uart_lut[uart].periph);
+        } else {
+            // Reading DR also clears a pending overrun, so reception recovers on its own
+            UART_Driver_AccountErrors(uart);
+            Ring_Buffer_Push(g_ring_buffer[uart], LL_USART_ReceiveData8(g_uart_lut[uart].periph));
+
+            /* Bursts longer than half the ring notify early, so the reader keeps up before the idle line */
+            sRingBufferSpan_t storage = {0};
+
+            if (Ring_Buffer_GetStorage(g_ring_buffer[uart], &storage) && ((storage.size / 2) == Ring_Buffer_GetCount(g_ring_buffer[uart]))) {
+                UART_Driver_NotifyReceive(uart);
+            }
+        }
+    }
+
+    #if defined(UART_DMA_RX)
+    if (LL_USART_IsEnabledIT_ERROR(g_uart_lut[uart].periph) && UART_Driver_AccountErrors(uart)) {
+        // DMA has normally fetched the byte already, the extra DR read completes the clear sequence
+        LL_USART_ClearFlag_ORE(g_uart_lut[uart].periph);
     }
-    
-    Ring_Buffer_Push(g_ring_buffer[uart], LL_USART_ReceiveData8(g_uart_lut[uart].periph));
-    
+    #endif /* UART_DMA_RX */
+
+    if (LL_USART_IsEnabledIT_IDLE(g_uart_lut[uart].periph) && LL_USART_IsActiveFlag_IDLE(g_uart_lut[uart].periph)) {
+        LL_USART_ClearFlag_IDLE(g_uart_lut[uart].periph);
+
+        #if defined(UART_DMA_RX)
+        if (UART_Driver_IsDmaRx(uart)) {
+            UART_Driver_DmaRxUpdate(uart);
+        }
+        #endif /* UART_DMA_RX */
+
+        UART_Driver_NotifyReceive(uart);
+    }
+
+    #if defined(UART_TX_RING)
+    if (LL_USART_IsEnabledIT_TXE(g_uart_lut[uart].periph) && LL_USART_IsActiveFlag_TXE(g_uart_lut[uart].periph)) {
+        UART_Driver_TxeISRHandler(uart);
+    }
+
+    if (LL_USART_IsEnabledIT_TC(g_uart_lut[uart].periph) && LL_USART_IsActiveFlag_TC(g_uart_lut[uart].periph)) {
+        UART_Driver_TcISRHandler(uart);
+    }
+    #endif /* UART_TX_RING */
+
     return;
 }
 
@@ -98,10 +629,25 @@ bool UART_Driver_Init (const eUart_t uart, const eBaudrate_t baudrate) {
     }
 
     g_uart_lut[uart] = *uart_desc;
+    g_error_lut[uart] = (sUartErrorStats_t) {0};
 
     g_uart_lut[uart].enable_clock_fp(g_uart_lut[uart].clock);
 
-    uart_init_struct.BaudRate = (eBaudrate_Default == baudrate) ? Baudrate_GetValue(g_uart_lut[uart].baud) : Baudrate_GetValue(baudrate);
+    eBaudrate_t selected_baudrate = (eBaudrate_Default == baudrate) ? g_uart_lut[uart].baud : baudrate;
+    uint32_t clock = UART_Driver_GetClock(uart);
+
+    // Rates the 16x divider cannot hit closely enough switch to the 8x high-speed profile
+    if ((LL_USART_OVERSAMPLING_16 == g_uart_lut[uart].oversample) && (Baudrate_GetErrorPermille(selected_baudrate, clock, 16U) > UART_BAUDRATE_MAX_ERROR_PERMILLE)) {
+        g_uart_lut[uart].oversample = LL_USART_OVERSAMPLING_8;
+    }
+
+    uint32_t oversampling = (LL_USART_OVERSAMPLING_8 == g_uart_lut[uart].oversample) ? 8U : 16U;
+
+    if (Baudrate_GetErrorPermille(selected_baudrate, clock, oversampling) > UART_BAUDRATE_MAX_ERROR_PERMILLE) {
+        return false;
+    }
+
+    uart_init_struct.BaudRate = Baudrate_GetValue(selected_baudrate);
     uart_init_struct.DataWidth = g_uart_lut[uart].data_bits;
     uart_init_struct.StopBits = g_uart_lut[uart].stop_bits;
     uart_init_struct.Parity = g_uart_lut[uart].parity;
@@ -118,14 +664,52 @@ bool UART_Driver_Init (const eUart_t uart, const eBaudrate_t baudrate) {
     NVIC_EnableIRQ(g_uart_lut[uart].nvic);
 
     if ((LL_USART_DIRECTION_RX == g_uart_lut[uart].direction) || (LL_USART_DIRECTION_TX_RX == g_uart_lut[uart].direction)) {
-        LL_USART_EnableIT_RXNE(g_uart_lut[uart].periph);
+        eRingBufferPolicy_t policy = UART_RX_RING_BUFFER_POLICY;
 
-        g_ring_buffer[uart] = Ring_Buffer_Init(g_uart_lut[uart].ring_buffer_capacity);
+        #if defined(UART_DMA_RX)
+        if (UART_Driver_IsDmaRx(uart)) {
+            policy = UART_DMA_RX_RING_BUFFER_POLICY;
+        }
+        #endif /* UART_DMA_RX */
+
+        if (NULL == g_ring_buffer[uart]) {
+            g_ring_buffer[uart] = Ring_Buffer_Init(g_uart_lut[uart].ring_buffer_capacity, policy);
+        }
 
         if (NULL == g_ring_buffer[uart]) {
             return false;
         }
+
+        #if defined(UART_DMA_RX)
+        if (UART_Driver_IsDmaRx(uart)) {
+            if (!UART_Driver_DmaRxInit(uart)) {
+                return false;
+            }
+
+            // Without RXNE interrupts line errors are only reported through the error interrupt
+            LL_USART_EnableIT_ERROR(g_uart_lut[uart].periph);
+        } else {
+            LL_USART_EnableIT_RXNE(g_uart_lut[uart].periph);
+        }
+        #else
+        LL_USART_EnableIT_RXNE(g_uart_lut[uart].periph);
+        #endif /* UART_DMA_RX */
+
+        LL_USART_EnableIT_IDLE(g_uart_lut[uart].periph);
+    }
+
+    #if defined(UART_TX_RING)
+    if (UART_Driver_IsTransmitAsync(uart)) {
+        g_tx_lut[uart].is_busy = false;
+        g_tx_lut[uart].transmitted = 0;
+
+        #if defined(UART_DMA_TX)
+        if (UART_Driver_IsDmaTx(uart) && !UART_Driver_DmaTxInit(uart)) {
+            return false;
+        }
+        #endif /* UART_DMA_TX */
     }
+    #endif /* UART_TX_RING */
 
     LL_USART_Enable(g_uart_lut[uart].periph);
 
@@ -141,6 +725,10 @@ bool UART_Driver_SendByte (const eUart_t uart, const uint8_t data) {
         return false;
     }
 
+    if (UART_Driver_IsTransmitAsync(uart)) {
+        return UART_Driver_TransmitAsync(uart, &data, 1);
+    }
+
     while (!LL_USART_IsActiveFlag_TXE(g_uart_lut[uart].periph)) {}
 
     LL_USART_TransmitData8(g_uart_lut[uart].periph, data);
@@ -156,6 +744,11 @@ bool UART_Driver_SendBytes (const eUart_t uart, uint8_t *data, const size_t size
         return false;
     }
 
+    // Queued transmits are all or nothing, a full ring is reported so the caller can wait or drop
+    if (UART_Driver_IsTransmitAsync(uart)) {
+        return UART_Driver_TransmitAsync(uart, data, size);
+    }
+
     for (size_t i = 0; i < size; i++) {
         if (!UART_Driver_SendByte(uart, data[i])) {
             return false;
@@ -178,7 +771,246 @@ bool UART_Driver_ReceiveByte (const eUart_t uart, uint8_t *data) {
         return false;
     }
 
-    return Ring_Buffer_Pop(g_ring_buffer[uart], data);
+    if (!Ring_Buffer_Pop(g_ring_buffer[uart], data)) {
+        return false;
+    }
+
+    UART_Driver_ResumeReceive(uart);
+
+    return true;
+}
+
+bool UART_Driver_ReceiveBytes (const eUart_t uart, uint8_t *data, const size_t size, size_t *received_size) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    if (!LL_USART_IsEnabled(g_uart_lut[uart].periph)) {
+        return false;
+    }
+
+    if ((NULL == data) || (NULL == received_size) || (0 == size)) {
+        return false;
+    }
+
+    *received_size = Ring_Buffer_PopBulk(g_ring_buffer[uart], data, size);
+
+    if (0 == *received_size) {
+        return false;
+    }
+
+    UART_Driver_ResumeReceive(uart);
+
+    return true;
+}
+
+/* Position is the free-running ring position the spans start at, ConsumeBytes takes it back */
+bool UART_Driver_PeekBytes (const eUart_t uart, size_t *position, sRingBufferSpan_t *first, sRingBufferSpan_t *second) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    if (!LL_USART_IsEnabled(g_uart_lut[uart].periph)) {
+        return false;
+    }
+
+    if ((NULL == position) || (NULL == first) || (NULL == second)) {
+        return false;
+    }
+
+    return Ring_Buffer_PeekTail(g_ring_buffer[uart], position, first, second);
+}
+
+/* Fails when the peeked bytes are gone, a DMA stream overwrote them while they were read and the frame is lost */
+bool UART_Driver_ConsumeBytes (const eUart_t uart, const size_t position, const size_t size) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    if (!LL_USART_IsEnabled(g_uart_lut[uart].periph)) {
+        return false;
+    }
+
+    #if defined(UART_DMA_RX)
+    /* DMA writes ahead of the last published position, publishing it first moves the tail over anything overwritten */
+    if (UART_Driver_IsDmaRx(uart)) {
+        UART_Driver_DmaRxUpdate(uart);
+    }
+    #endif /* UART_DMA_RX */
+
+    if (!Ring_Buffer_ConsumeFrom(g_ring_buffer[uart], position, size)) {
+        return false;
+    }
+
+    UART_Driver_ResumeReceive(uart);
+
+    return true;
+}
+
+bool UART_Driver_IsReceiveBufferFull (const eUart_t uart) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    return Ring_Buffer_IsFull(g_ring_buffer[uart]);
+}
+
+bool UART_Driver_GetReceiveStats (const eUart_t uart, sRingBufferStats_t *stats) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    if (NULL == stats) {
+        return false;
+    }
+
+    return Ring_Buffer_GetStats(g_ring_buffer[uart], stats);
+}
+
+bool UART_Driver_GetErrorStats (const eUart_t uart, sUartErrorStats_t *stats) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    if (NULL == stats) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    *stats = g_error_lut[uart];
+
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+/* Callback runs in interrupt context on an idle line, after half a ring of data, or on DMA half/full transfer */
+bool UART_Driver_SetReceiveCallback (const eUart_t uart, uart_rx_callback_t callback, void *context) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    g_rx_callback_lut[uart].callback = callback;
+    g_rx_callback_lut[uart].context = context;
+
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+bool UART_Driver_IsTransmitAsync (const eUart_t uart) {
+    if (!UART_Config_IsCorrectUart(uart)) {
+        return false;
+    }
+
+    #if defined(UART_TX_RING)
+    return (NULL != g_tx_ring_buffer[uart]);
+    #else
+    return false;
+    #endif /* UART_TX_RING */
+}
+
+bool UART_Driver_SetTransmitCallback (const eUart_t uart, uart_tx_callback_t callback, void *context) {
+    if (!UART_Driver_IsTransmitAsync(uart)) {
+        return false;
+    }
+
+    #if defined(UART_TX_RING)
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    g_tx_lut[uart].callback = callback;
+    g_tx_lut[uart].callback_context = context;
+
+    __set_PRIMASK(primask);
+    #endif /* UART_TX_RING */
+
+    return true;
+}
+
+bool UART_Driver_GetTransmitFree (const eUart_t uart, size_t *free_size) {
+    if (!UART_Driver_IsTransmitAsync(uart)) {
+        return false;
+    }
+
+    if (NULL == free_size) {
+        return false;
+    }
+
+    #if defined(UART_TX_RING)
+    sRingBufferSpan_t storage = {0};
+
+    if (!Ring_Buffer_GetStorage(g_tx_ring_buffer[uart], &storage)) {
+        return false;
+    }
+
+    *free_size = storage.size - Ring_Buffer_GetCount(g_tx_ring_buffer[uart]);
+    #endif /* UART_TX_RING */
+
+    return true;
+}
+
+/* Queues the whole buffer or nothing and returns without waiting for the wire, single producer per UART */
+bool UART_Driver_TransmitAsync (const eUart_t uart, const uint8_t *data, const size_t size) {
+    if (!UART_Driver_IsTransmitAsync(uart)) {
+        return false;
+    }
+
+    if (!LL_USART_IsEnabled(g_uart_lut[uart].periph)) {
+        return false;
+    }
+
+    if ((NULL == data) || (0 == size)) {
+        return false;
+    }
+
+    size_t free_size = 0;
+
+    if (!UART_Driver_GetTransmitFree(uart, &free_size) || (free_size < size)) {
+        return false;
+    }
+
+    #if defined(UART_TX_RING)
+    if (size != Ring_Buffer_PushBulk(g_tx_ring_buffer[uart], data, size)) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!g_tx_lut[uart].is_busy) {
+        UART_Driver_TransmitStart(uart);
+    }
+
+    __set_PRIMASK(primask);
+    #endif /* UART_TX_RING */
+
+    return true;
+}
+
+/* Runs the transmit callback now if the transmitter already went idle, a busy one notifies on its own when done */
+bool UART_Driver_NotifyTransmitIdle (const eUart_t uart) {
+    if (!UART_Driver_IsTransmitAsync(uart)) {
+        return false;
+    }
+
+    #if defined(UART_TX_RING)
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!g_tx_lut[uart].is_busy) {
+        UART_Driver_NotifyTransmit(uart);
+    }
+
+    __set_PRIMASK(primask);
+    #endif /* UART_TX_RING */
+
+    return true;
 }
 
 #endif /* ENABLE_UART */
@@ -11,6 +11,23 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "uart_config.h"
+#include "ring_buffer.h"
+
+#if defined(ENABLE_DMA) && ((defined(UART1) && defined(UART_1_RX_DMA_STREAM)) || (defined(UART2) && defined(UART_2_RX_DMA_STREAM)))
+#define UART_DMA_RX
+#endif /* ENABLE_DMA && UART_x_RX_DMA_STREAM */
+
+#if (defined(UART1) && defined(UART_1_TX_RING_BUFFER_CAPACITY)) || (defined(UART2) && defined(UART_2_TX_RING_BUFFER_CAPACITY))
+#define UART_TX_RING
+#endif /* UART_x_TX_RING_BUFFER_CAPACITY */
+
+#if defined(ENABLE_DMA) && ((defined(UART1) && defined(UART_1_TX_DMA_STREAM) && defined(UART_1_TX_RING_BUFFER_CAPACITY)) || (defined(UART2) && defined(UART_2_TX_DMA_STREAM) && defined(UART_2_TX_RING_BUFFER_CAPACITY)))
+#define UART_DMA_TX
+#endif /* ENABLE_DMA && UART_x_TX_DMA_STREAM && UART_x_TX_RING_BUFFER_CAPACITY */
+
+#if defined(UART_DMA_RX) || defined(UART_DMA_TX)
+#include "dma_driver.h"
+#endif /* UART_DMA_RX || UART_DMA_TX */
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -20,6 +37,20 @@
  * Exported types
  *********************************************************************************************************************/
 
+/* clang-format off */
+typedef struct sUartErrorStats {
+    uint32_t overrun;
+    uint32_t framing;
+    uint32_t noise;
+    uint32_t parity;
+} sUartErrorStats_t;
+/* clang-format on */
+
+typedef void (*uart_rx_callback_t) (void *context);
+
+/* Called from interrupt context as the transmit ring drains, transmitted is the free-running byte total */
+typedef void (*uart_tx_callback_t) (void *context, const size_t transmitted);
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -32,6 +63,18 @@ bool UART_Driver_Init (const eUart_t uart, const eBaudrate_t baudrate);
 bool UART_Driver_SendByte (const eUart_t uart, const uint8_t data);
 bool UART_Driver_SendBytes (const eUart_t uart, uint8_t *data, const size_t size);
 bool UART_Driver_ReceiveByte (const eUart_t uart, uint8_t *data);
+bool UART_Driver_ReceiveBytes (const eUart_t uart, uint8_t *data, const size_t size, size_t *received_size);
+bool UART_Driver_PeekBytes (const eUart_t uart, size_t *position, sRingBufferSpan_t *first, sRingBufferSpan_t *second);
+bool UART_Driver_ConsumeBytes (const eUart_t uart, const size_t position, const size_t size);
+bool UART_Driver_IsReceiveBufferFull (const eUart_t uart);
+bool UART_Driver_GetReceiveStats (const eUart_t uart, sRingBufferStats_t *stats);
+bool UART_Driver_GetErrorStats (const eUart_t uart, sUartErrorStats_t *stats);
+bool UART_Driver_SetReceiveCallback (const eUart_t uart, uart_rx_callback_t callback, void *context);
+bool UART_Driver_IsTransmitAsync (const eUart_t uart);
+bool UART_Driver_SetTransmitCallback (const eUart_t uart, uart_tx_callback_t callback, void *context);
+bool UART_Driver_GetTransmitFree (const eUart_t uart, size_t *free_size);
+bool UART_Driver_TransmitAsync (const eUart_t uart, const uint8_t *data, const size_t size);
+bool UART_Driver_NotifyTransmitIdle (const eUart_t uart);
 
 #endif /* ENABLE_UART */
 #endif /* SOURCE_DRIVER_UART_DRIVER_H_ */
@@ -8,6 +8,9 @@
  * Private definitions and macros
  *********************************************************************************************************************/
 
+/* BRR holds a 12 bit mantissa and a fraction of log2(oversampling) bits */
+#define BAUDRATE_MAX_DIVIDER(oversampling) ((4096UL * (oversampling)) - 1UL)
+
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
@@ -29,7 +32,9 @@ static const uint32_t g_static_baudrate_lut[eBaudrate_Last] = {
     [eBaudrate_460800] = 460800,
     [eBaudrate_921600] = 921600,
     [eBaudrate_1000000] = 1000000,
-    [eBaudrate_2000000] = 2000000
+    [eBaudrate_1500000] = 1500000,
+    [eBaudrate_2000000] = 2000000,
+    [eBaudrate_3000000] = 3000000
 };
 /* clang-format on */
 
@@ -60,3 +65,28 @@ const uint32_t Baudrate_GetValue (const eBaudrate_t baudrate) {
 
     return g_static_baudrate_lut[baudrate];
 }
+
+/* Deviation of the closest rate the USART fractional divider produces from clock_hz, oversampling is 8 or 16 */
+uint32_t Baudrate_GetErrorPermille (const eBaudrate_t baudrate, const uint32_t clock_hz, const uint32_t oversampling) {
+    if ((8U != oversampling) && (16U != oversampling)) {
+        return BAUDRATE_ERROR_INVALID;
+    }
+
+    uint32_t value = Baudrate_GetValue(baudrate);
+
+    if ((0 == value) || (0 == clock_hz)) {
+        return BAUDRATE_ERROR_INVALID;
+    }
+
+    // USARTDIV scaled by the oversampling, rounded the same way the LL divider macros do
+    uint32_t divider = (clock_hz + (value / 2)) / value;
+
+    if ((divider < oversampling) || (divider > BAUDRATE_MAX_DIVIDER(oversampling))) {
+        return BAUDRATE_ERROR_INVALID;
+    }
+
+    uint32_t actual = clock_hz / divider;
+    uint32_t deviation = (actual > value) ? (actual - value) : (value - actual);
+
+    return (uint32_t) (((uint64_t) deviation * 1000U) / value);
+}
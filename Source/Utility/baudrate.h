@@ -10,6 +10,9 @@
  * Exported definitions and macros
  *********************************************************************************************************************/
 
+/* Returned by Baudrate_GetErrorPermille when the USART divider cannot produce the rate at all */
+#define BAUDRATE_ERROR_INVALID UINT32_MAX
+
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
@@ -28,7 +31,9 @@ typedef enum eBaudrate {
     eBaudrate_460800,
     eBaudrate_921600,
     eBaudrate_1000000,
+    eBaudrate_1500000,
     eBaudrate_2000000,
+    eBaudrate_3000000,
     eBaudrate_Last
 } eBaudrate_t;
 /* clang-format on */
@@ -42,5 +47,6 @@ typedef enum eBaudrate {
  *********************************************************************************************************************/
 
 const uint32_t Baudrate_GetValue (const eBaudrate_t baudrate);
+uint32_t Baudrate_GetErrorPermille (const eBaudrate_t baudrate, const uint32_t clock_hz, const uint32_t oversampling);
 
 #endif /* SOURCE_UTILITY_BAUDRATE_H_ */
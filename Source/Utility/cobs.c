@@ -0,0 +1,123 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "cobs.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+#define COBS_MAX_BLOCK_CODE 0xFFU
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/* Consistent Overhead Byte Stuffing, the encoded output contains no 0x00 so it can be used as the frame delimiter */
+bool COBS_Encode (const uint8_t *source, const size_t source_size, uint8_t *destination, const size_t destination_capacity, size_t *encoded_size) {
+    if ((NULL == source) || (NULL == destination) || (NULL == encoded_size)) {
+        return false;
+    }
+
+    if (destination_capacity < COBS_MAX_ENCODED_SIZE(source_size)) {
+        return false;
+    }
+
+    size_t code_index = 0;
+    size_t write_index = 1;
+    uint8_t code = 1;
+
+    for (size_t read_index = 0; read_index < source_size; read_index++) {
+        if (0 != source[read_index]) {
+            destination[write_index++] = source[read_index];
+            code++;
+        }
+
+        if ((0 == source[read_index]) || (COBS_MAX_BLOCK_CODE == code)) {
+            destination[code_index] = code;
+            code_index = write_index++;
+            code = 1;
+
+            /* A full block at the very end needs no trailing empty block */
+            if ((0 != source[read_index]) && ((read_index + 1) == source_size)) {
+                *encoded_size = code_index;
+
+                return true;
+            }
+        }
+    }
+
+    destination[code_index] = code;
+
+    *encoded_size = write_index;
+
+    return true;
+}
+
+/* Destination may alias source, decoding never writes ahead of the read position */
+bool COBS_Decode (const uint8_t *source, const size_t source_size, uint8_t *destination, const size_t destination_capacity, size_t *decoded_size) {
+    if ((NULL == source) || (NULL == destination) || (NULL == decoded_size)) {
+        return false;
+    }
+
+    size_t read_index = 0;
+    size_t write_index = 0;
+
+    while (read_index < source_size) {
+        uint8_t code = source[read_index++];
+
+        if ((0 == code) || ((read_index + code - 1) > source_size)) {
+            return false;
+        }
+
+        if ((write_index + code - 1) > destination_capacity) {
+            return false;
+        }
+
+        for (uint8_t i = 1; i < code; i++) {
+            if (0 == source[read_index]) {
+                return false;
+            }
+
+            destination[write_index++] = source[read_index++];
+        }
+
+        /* Every block except a full one and the last one stands for a zero byte */
+        if ((COBS_MAX_BLOCK_CODE != code) && (read_index < source_size)) {
+            if (write_index >= destination_capacity) {
+                return false;
+            }
+
+            destination[write_index++] = 0;
+        }
+    }
+
+    *decoded_size = write_index;
+
+    return true;
+}
@@ -0,0 +1,33 @@
+#ifndef SOURCE_UTILITY_COBS_H_
+#define SOURCE_UTILITY_COBS_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/* Worst case encoded size (one overhead byte per 254 data bytes plus the leading code), without the 0x00 delimiter */
+#define COBS_MAX_ENCODED_SIZE(size) ((size) + ((size) / 254U) + 1U)
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+bool COBS_Encode (const uint8_t *source, const size_t source_size, uint8_t *destination, const size_t destination_capacity, size_t *encoded_size);
+bool COBS_Decode (const uint8_t *source, const size_t source_size, uint8_t *destination, const size_t destination_capacity, size_t *decoded_size);
+
+#endif /* SOURCE_UTILITY_COBS_H_ */
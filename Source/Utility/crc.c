@@ -0,0 +1,60 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "crc.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/* CRC-16/CCITT-FALSE (poly 0x1021), nibble table keeps flash use at 32 bytes */
+static const uint16_t g_crc16_nibble_lut[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+ 
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+uint16_t CRC16_Update (uint16_t crc, const uint8_t *data, const size_t size) {
+    if (NULL == data) {
+        return crc;
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        crc = (uint16_t) ((crc << 4) ^ g_crc16_nibble_lut[((crc >> 12) ^ (data[i] >> 4)) & 0x0FU]);
+        crc = (uint16_t) ((crc << 4) ^ g_crc16_nibble_lut[((crc >> 12) ^ data[i]) & 0x0FU]);
+    }
+
+    return crc;
+}
+
+uint16_t CRC16_Calculate (const uint8_t *data, const size_t size) {
+    return CRC16_Update(CRC16_INITIAL_VALUE, data, size);
+}
@@ -0,0 +1,31 @@
+#ifndef SOURCE_UTILITY_CRC_H_
+#define SOURCE_UTILITY_CRC_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+#define CRC16_INITIAL_VALUE 0xFFFFU
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+uint16_t CRC16_Update (uint16_t crc, const uint8_t *data, const size_t size);
+uint16_t CRC16_Calculate (const uint8_t *data, const size_t size);
+
+#endif /* SOURCE_UTILITY_CRC_H_ */
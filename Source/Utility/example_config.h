@@ -30,6 +30,9 @@
 /// -- UART                    // Enable UART functionality
 #define ENABLE_UART
 
+/// -- PACKET                  // Enable COBS/CRC binary packet transport over UART
+#define ENABLE_PACKET
+
 /// -- PWM                     // Enable PWM functionality
 #define ENABLE_PWM
 
@@ -60,6 +63,9 @@
 /// -- DMA                     // Enable DMA functionality
 #define ENABLE_DMA
 
+/// -- Cycle counter           // Enable DWT core cycle counter (Cortex-M3 and up)
+#define ENABLE_CYCLE_COUNTER
+
 /// -- I²C bus                 // Enable I2C functionality
 #define ENABLE_I2C
 
@@ -96,9 +102,18 @@
 #if defined(ENABLE_UART)
 // #define UART1 
 // #define UART_1_BAUDRATE eBaudrate_115200
+// #define UART_1_RING_BUFFER_CAPACITY 256
 
 #define UART2 eUart_Debug
 #define UART_2_BAUDRATE eBaudrate_115200
+/// Static RX ring buffer capacity, must be a power of two (omit to allocate from heap)
+#define UART_2_RING_BUFFER_CAPACITY 256
+/// Circular DMA stream (periph-to-memory, byte size, memory increment) for RX with idle-line detection (omit for RXNE interrupts)
+// #define UART_2_RX_DMA_STREAM eDma_Uart_2_Rx
+/// Power of two queue capacity for non-blocking TX, drained by TXE/TC interrupts (omit for blocking TX)
+// #define UART_2_TX_RING_BUFFER_CAPACITY 512
+/// Normal mode DMA stream (memory-to-periph, byte size, memory increment) draining the TX queue instead of interrupts
+// #define UART_2_TX_DMA_STREAM eDma_Uart_2_Tx
 
 #if defined(ENABLE_UART_DEBUG)
 #define DEBUG_UART UART2
@@ -109,11 +124,43 @@
 
 #define DEBUG_MESSAGE_TIMEOUT 1000
 #define DEBUG_MUTEX_TIMEOUT 0U
+
+/// Deferred logging, traces are formatted into a lock-free ring and sent by a low priority thread (callable from ISRs)
+// #define DEBUG_DEFERRED
+#if defined(DEBUG_DEFERRED)
+/// Number of DEBUG_MESSAGE_SIZE lines queued before new ones are dropped, must be a power of two
+#define DEBUG_LOG_RING_CAPACITY 8U
+#define DEBUG_LOG_THREAD_STACK_SIZE (256 * 4)
+#define DEBUG_LOG_THREAD_PRIORITY osPriorityLow
+#endif /* DEBUG_DEFERRED */
+
+/// Flight recorder, traces go to a RAM ring kept across resets instead of the UART (dump with trace_dump:)
+/// Only CLI feedback (TRACE_CLI_INFO/TRACE_CLI_WRN) still goes to the UART, any other trace is silent until trace_dump:
+// #define DEBUG_FLIGHT_RECORDER
+#if defined(DEBUG_FLIGHT_RECORDER)
+/// Recorder size in bytes, must be a power of two, the linker script needs a .noinit (NOLOAD) section
+#define DEBUG_RECORDER_CAPACITY 4096U
+#endif /* DEBUG_FLIGHT_RECORDER */
+
+/// Prefix every trace with the DWT cycle count (convert captures with Tools/trace_to_chrome.py)
+// #define DEBUG_TIMESTAMP
+
+/// Tokenized traces, only string offsets and raw arguments are sent (decode with Tools/trace_decoder.py)
+// #define DEBUG_TOKENIZED
+#if defined(DEBUG_TOKENIZED)
+/// Largest binary trace payload, DEBUG_MESSAGE_SIZE must hold its COBS encoding
+#define DEBUG_TOKEN_PAYLOAD_SIZE 64U
+#endif /* DEBUG_TOKENIZED */
 #endif /* ENABLE_UART_DEBUG */
 
 #define MESSAGE_QUEUE_PRIORITY 0U
 #define MESSAGE_QUEUE_CAPACITY 10
 #define MESSAGE_QUEUE_PUT_TIMEOUT 0U
+
+#if defined(ENABLE_PACKET)
+/// Largest packet payload, the UART buffer_capacity must fit COBS_MAX_ENCODED_SIZE(PACKET_MAX_PAYLOAD_SIZE + 3)
+#define PACKET_MAX_PAYLOAD_SIZE 128U
+#endif /* ENABLE_PACKET */
 #endif /* ENABLE_UART */
 
 //=============================================================================
@@ -186,8 +233,8 @@
 // #define DMA_1_STREAM_2
 // #define DMA_1_STREAM_3
 #define DMA_1_STREAM_4 eDma_Ws2812b_1
-// #define DMA_1_STREAM_5
-// #define DMA_1_STREAM_6
+// #define DMA_1_STREAM_5 eDma_Uart_2_Rx
+// #define DMA_1_STREAM_6 eDma_Uart_2_Tx
 // #define DMA_1_STREAM_7
 
 // #define DMA_2_STREAM_0
@@ -214,6 +261,9 @@
 //-----------------------------------------------------------------------------
 
 #if defined(ENABLE_UART_DEBUG)
+/// Compile out traces below this level together with their arguments (e.g. eTraceLevel_Warning for release builds)
+// #define TRACE_LEVEL_MIN eTraceLevel_Warning
+
 // Custom debug flags
 #define DEBUG_MAIN
 #define CUSTOM_CLI_CMD_HANDLERS
@@ -282,6 +332,29 @@
 
 #define HEAP_API_MUTEX_TIMEOUT 0U
 
+/// Fixed block pools served in O(1) without the heap mutex, list them in ascending block size
+/// Heap_API_Calloc takes the smallest pool with a free block that fits and falls back to the heap otherwise
+#define HEAP_POOL_1_BLOCK_SIZE 16U
+#define HEAP_POOL_1_BLOCK_COUNT 16U
+#define HEAP_POOL_2_BLOCK_SIZE 32U
+#define HEAP_POOL_2_BLOCK_COUNT 8U
+// #define HEAP_POOL_3_BLOCK_SIZE 64U
+// #define HEAP_POOL_3_BLOCK_COUNT 4U
+// #define HEAP_POOL_4_BLOCK_SIZE 128U
+// #define HEAP_POOL_4_BLOCK_COUNT 2U
+
+/// Serve the heap from a static TLSF region instead of the C library, O(1) allocate and free with bounded fragmentation
+// #define HEAP_TLSF_SIZE (16U * 1024U)
+
+/// Track bytes in use, peak, size histogram and outstanding bytes per call site, reported by heap_stats:
+/// Adds an 8 byte header to every allocation and takes the heap mutex on the pool path too
+// #define HEAP_STATS
+#define HEAP_STATS_SITE_COUNT 16U
+
+/// Create every framework thread, mutex, timer, queue and event flag group from a static arena instead of the RTOS heap
+/// Needs configSUPPORT_STATIC_ALLOCATION, check RTOS_API_GetArenaUsage after start up and trim the size to it
+// #define RTOS_STATIC_ARENA_SIZE (8U * 1024U)
+
 #define BYTE 8
 #define BASE_10 10
 #define MAX_PID_DT 0.5f  // Maximum dt for PID update to avoid large jumps
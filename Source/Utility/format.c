@@ -0,0 +1,410 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "format.h"
+#include <stdbool.h>
+#include <limits.h>
+#include <math.h>
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/* Holds a 64 bit decimal integer, or 10 integer digits, the point and FORMAT_FLOAT_MAX_PRECISION digits */
+#define FORMAT_NUMBER_SIZE 24U
+#define FORMAT_NO_PRECISION (-1)
+
+#define FORMAT_BASE_10 10U
+#define FORMAT_BASE_16 16U
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef struct sFormatOutput {
+    char *buffer;
+    size_t capacity;
+    size_t length;
+} sFormatOutput_t;
+
+typedef struct sFormatSpec {
+    bool is_left_aligned;
+    bool is_zero_padded;
+    size_t width;
+    int precision;
+} sFormatSpec_t;
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+static const char g_lower_digits[] = "0123456789abcdef";
+static const char g_upper_digits[] = "0123456789ABCDEF";
+
+static const uint32_t g_pow10_lut[FORMAT_FLOAT_MAX_PRECISION + 1] = {1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static void Format_PutChar (sFormatOutput_t *output, const char character);
+static void Format_PutRepeated (sFormatOutput_t *output, const char character, size_t count);
+static void Format_PutField (sFormatOutput_t *output, const sFormatSpec_t *spec, const char *sign, const char *body, const size_t body_length, const bool is_number);
+static size_t Format_ToDigits (char *end, unsigned long long value, const unsigned int base, const char *digits);
+static void Format_PutInteger (sFormatOutput_t *output, const sFormatSpec_t *spec, const unsigned long long magnitude, const bool is_negative, const unsigned int base, const char *digits);
+static void Format_PutFloat (sFormatOutput_t *output, const sFormatSpec_t *spec, const double value);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+static void Format_PutChar (sFormatOutput_t *output, const char character) {
+    if (output->length < output->capacity) {
+        output->buffer[output->length] = character;
+        output->length++;
+    }
+
+    return;
+}
+
+static void Format_PutRepeated (sFormatOutput_t *output, const char character, size_t count) {
+    while (count > 0) {
+        Format_PutChar(output, character);
+        count--;
+    }
+
+    return;
+}
+
+/* Zero padding goes between the sign and the digits, space padding in front of the sign */
+static void Format_PutField (sFormatOutput_t *output, const sFormatSpec_t *spec, const char *sign, const char *body, const size_t body_length, const bool is_number) {
+    size_t sign_length = (NULL == sign) ? 0 : 1;
+    size_t padding = 0;
+
+    if (spec->width > (sign_length + body_length)) {
+        padding = spec->width - (sign_length + body_length);
+    }
+
+    bool is_zero_padded = is_number && spec->is_zero_padded && !spec->is_left_aligned;
+
+    if (!spec->is_left_aligned && !is_zero_padded) {
+        Format_PutRepeated(output, ' ', padding);
+    }
+
+    if (NULL != sign) {
+        Format_PutChar(output, *sign);
+    }
+
+    if (is_zero_padded) {
+        Format_PutRepeated(output, '0', padding);
+    }
+
+    for (size_t index = 0; index < body_length; index++) {
+        Format_PutChar(output, body[index]);
+    }
+
+    if (spec->is_left_aligned) {
+        Format_PutRepeated(output, ' ', padding);
+    }
+
+    return;
+}
+
+/* Writes the digits backwards ending just before end, returns how many were written */
+static size_t Format_ToDigits (char *end, unsigned long long value, const unsigned int base, const char *digits) {
+    size_t count = 0;
+
+    /* 64 bit division is a library call on the target, it only runs until the rest fits in an unsigned long */
+    while (value > ULONG_MAX) {
+        end--;
+        *end = digits[value % base];
+        value /= base;
+        count++;
+    }
+
+    unsigned long rest = (unsigned long) value;
+
+    do {
+        end--;
+        *end = digits[rest % base];
+        rest /= base;
+        count++;
+    } while (0 != rest);
+
+    return count;
+}
+
+static void Format_PutInteger (sFormatOutput_t *output, const sFormatSpec_t *spec, const unsigned long long magnitude, const bool is_negative, const unsigned int base, const char *digits) {
+    char number[FORMAT_NUMBER_SIZE];
+
+    size_t length = Format_ToDigits(&number[FORMAT_NUMBER_SIZE], magnitude, base, digits);
+
+    Format_PutField(output, spec, is_negative ? "-" : NULL, &number[FORMAT_NUMBER_SIZE - length], length, true);
+
+    return;
+}
+
+/* Fixed point rendering in single precision, so the FPU does the work and the soft double printf is never linked */
+static void Format_PutFloat (sFormatOutput_t *output, const sFormatSpec_t *spec, const double value) {
+    float magnitude = (float) value;
+
+    if (isnan(magnitude)) {
+        Format_PutField(output, spec, NULL, "nan", 3, false);
+
+        return;
+    }
+
+    bool is_negative = signbit(magnitude);
+
+    if (is_negative) {
+        magnitude = -magnitude;
+    }
+
+    if (magnitude >= 4294967296.0f) {
+        Format_PutField(output, spec, is_negative ? "-" : NULL, isinf(magnitude) ? "inf" : "ovf", 3, false);
+
+        return;
+    }
+
+    size_t precision = FORMAT_FLOAT_DEFAULT_PRECISION;
+
+    if (FORMAT_NO_PRECISION != spec->precision) {
+        precision = ((size_t) spec->precision > FORMAT_FLOAT_MAX_PRECISION) ? FORMAT_FLOAT_MAX_PRECISION : (size_t) spec->precision;
+    }
+
+    uint32_t integer = (uint32_t) magnitude;
+    uint32_t fraction = (uint32_t) (((magnitude - (float) integer) * (float) g_pow10_lut[precision]) + 0.5f);
+
+    if (fraction >= g_pow10_lut[precision]) {
+        fraction -= g_pow10_lut[precision];
+        integer++;
+    }
+
+    char number[FORMAT_NUMBER_SIZE];
+    size_t length = 0;
+
+    if (precision > 0) {
+        for (size_t digit = 1; digit <= precision; digit++) {
+            number[FORMAT_NUMBER_SIZE - digit] = g_lower_digits[fraction % FORMAT_BASE_10];
+            fraction /= FORMAT_BASE_10;
+        }
+
+        number[FORMAT_NUMBER_SIZE - precision - 1] = '.';
+        length = precision + 1;
+    }
+
+    length += Format_ToDigits(&number[FORMAT_NUMBER_SIZE - length], integer, FORMAT_BASE_10, g_lower_digits);
+
+    Format_PutField(output, spec, is_negative ? "-" : NULL, &number[FORMAT_NUMBER_SIZE - length], length, true);
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+size_t Format_Print (char *buffer, const size_t size, const char *format, ...) {
+    va_list arguments;
+
+    va_start(arguments, format);
+
+    size_t length = Format_VPrint(buffer, size, format, arguments);
+
+    va_end(arguments);
+
+    return length;
+}
+
+/* Bounded printf subset: d i u x X c s p f %, flags '-' '0', width, precision (digits or '*'), modifiers h l ll j z */
+/* Unlike snprintf it returns the characters actually written, the output is always terminated and cut to size - 1 */
+size_t Format_VPrint (char *buffer, const size_t size, const char *format, va_list arguments) {
+    if ((NULL == buffer) || (0 == size)) {
+        return 0;
+    }
+
+    sFormatOutput_t output = {.buffer = buffer, .capacity = (size - 1), .length = 0};
+
+    if (NULL == format) {
+        buffer[0] = '\0';
+
+        return 0;
+    }
+
+    while (('\0' != *format) && (output.length < output.capacity)) {
+        if ('%' != *format) {
+            Format_PutChar(&output, *format);
+            format++;
+
+            continue;
+        }
+
+        format++;
+
+        sFormatSpec_t spec = {.is_left_aligned = false, .is_zero_padded = false, .width = 0, .precision = FORMAT_NO_PRECISION};
+
+        for (;; format++) {
+            if ('-' == *format) {
+                spec.is_left_aligned = true;
+            } else if ('0' == *format) {
+                spec.is_zero_padded = true;
+            } else {
+                break;
+            }
+        }
+
+        if ('*' == *format) {
+            int width = va_arg(arguments, int);
+
+            if (width < 0) {
+                spec.is_left_aligned = true;
+                width = -width;
+            }
+
+            spec.width = (size_t) width;
+            format++;
+        } else {
+            while ((*format >= '0') && (*format <= '9')) {
+                spec.width = (spec.width * FORMAT_BASE_10) + (size_t) (*format - '0');
+                format++;
+            }
+        }
+
+        if ('.' == *format) {
+            format++;
+            spec.precision = 0;
+
+            if ('*' == *format) {
+                spec.precision = va_arg(arguments, int);
+                format++;
+
+                if (spec.precision < 0) {
+                    spec.precision = FORMAT_NO_PRECISION;
+                }
+            } else {
+                while ((*format >= '0') && (*format <= '9')) {
+                    spec.precision = (spec.precision * (int) FORMAT_BASE_10) + (*format - '0');
+                    format++;
+                }
+            }
+        }
+
+        bool is_long = false;
+        bool is_long_long = false;
+        bool is_max = false;
+        bool is_size = false;
+
+        for (;; format++) {
+            if ('l' == *format) {
+                is_long_long = is_long;
+                is_long = true;
+            } else if ('j' == *format) {
+                is_max = true;
+            } else if ('z' == *format) {
+                is_size = true;
+            } else if ('h' != *format) {
+                break;
+            }
+        }
+
+        switch (*format) {
+            case 'd':
+            case 'i': {
+                long long value = 0;
+
+                if (is_max) {
+                    value = (long long) va_arg(arguments, intmax_t);
+                } else if (is_long_long) {
+                    value = va_arg(arguments, long long);
+                } else if (is_size) {
+                    value = (long) va_arg(arguments, size_t);
+                } else if (is_long) {
+                    value = va_arg(arguments, long);
+                } else {
+                    value = va_arg(arguments, int);
+                }
+
+                unsigned long long magnitude = (value < 0) ? (0ULL - (unsigned long long) value) : (unsigned long long) value;
+
+                Format_PutInteger(&output, &spec, magnitude, (value < 0), FORMAT_BASE_10, g_lower_digits);
+            } break;
+            case 'u':
+            case 'x':
+            case 'X': {
+                unsigned long long value = 0;
+
+                if (is_max) {
+                    value = (unsigned long long) va_arg(arguments, uintmax_t);
+                } else if (is_long_long) {
+                    value = va_arg(arguments, unsigned long long);
+                } else if (is_size) {
+                    value = va_arg(arguments, size_t);
+                } else if (is_long) {
+                    value = va_arg(arguments, unsigned long);
+                } else {
+                    value = va_arg(arguments, unsigned int);
+                }
+
+                unsigned int base = ('u' == *format) ? FORMAT_BASE_10 : FORMAT_BASE_16;
+
+                Format_PutInteger(&output, &spec, value, false, base, ('X' == *format) ? g_upper_digits : g_lower_digits);
+            } break;
+            case 'p': {
+                Format_PutChar(&output, '0');
+                Format_PutChar(&output, 'x');
+                Format_PutInteger(&output, &spec, (unsigned long) (uintptr_t) va_arg(arguments, void *), false, FORMAT_BASE_16, g_lower_digits);
+            } break;
+            case 'c': {
+                char character = (char) va_arg(arguments, int);
+
+                Format_PutField(&output, &spec, NULL, &character, 1, false);
+            } break;
+            case 's': {
+                const char *string = va_arg(arguments, const char *);
+
+                if (NULL == string) {
+                    string = "(null)";
+                }
+
+                size_t length = 0;
+
+                while (('\0' != string[length]) && ((FORMAT_NO_PRECISION == spec.precision) || (length < (size_t) spec.precision))) {
+                    length++;
+                }
+
+                Format_PutField(&output, &spec, NULL, string, length, false);
+            } break;
+            case 'f':
+            case 'F': {
+                Format_PutFloat(&output, &spec, va_arg(arguments, double));
+            } break;
+            case '%': {
+                Format_PutChar(&output, '%');
+            } break;
+            case '\0': {
+                format--;
+            } break;
+            default: {
+                Format_PutChar(&output, '%');
+                Format_PutChar(&output, *format);
+            } break;
+        }
+
+        format++;
+    }
+
+    buffer[output.length] = '\0';
+
+    return output.length;
+}
@@ -0,0 +1,34 @@
+#ifndef SOURCE_UTILITY_FORMAT_H_
+#define SOURCE_UTILITY_FORMAT_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/* Digits after the point for %f without a precision, larger precisions are clamped to FORMAT_FLOAT_MAX_PRECISION */
+#define FORMAT_FLOAT_DEFAULT_PRECISION 6U
+#define FORMAT_FLOAT_MAX_PRECISION 6U
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+size_t Format_Print (char *buffer, const size_t size, const char *format, ...) __attribute__((format(printf, 3, 4)));
+size_t Format_VPrint (char *buffer, const size_t size, const char *format, va_list arguments);
+
+#endif /* SOURCE_UTILITY_FORMAT_H_ */
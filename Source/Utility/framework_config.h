@@ -27,6 +27,14 @@
 #error "DEBUG_UART requires UART to be enabled."
 #endif /* ENABLE_UART_DEBUG && !ENABLE_UART */
 
+#if defined(DEBUG_TIMESTAMP) && !defined(ENABLE_CYCLE_COUNTER)
+#error "DEBUG_TIMESTAMP requires CYCLE_COUNTER to be enabled."
+#endif /* DEBUG_TIMESTAMP && !ENABLE_CYCLE_COUNTER */
+
+#if defined(ENABLE_PACKET) && !defined(ENABLE_UART)
+#error "PACKET requires UART to be enabled."
+#endif /* ENABLE_PACKET && !ENABLE_UART */
+
 #if defined(ENABLE_CLI) && (!defined(DEBUG_UART) || !defined(ENABLE_UART_DEBUG))
 #error "CLI requires DEBUG_UART to be enabled."
 #endif /* ENABLE_CLI && (!DEBUG_UART || !ENABLE_UART_DEBUG) */
@@ -4,6 +4,8 @@
 
 #include "ring_buffer.h"
 
+#include <string.h>
+
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
@@ -12,16 +14,6 @@
  * Private typedef
  *********************************************************************************************************************/
 
-/* clang-format off */
-struct sRingBufferDesc {
-    size_t buffer_capacity;
-    size_t head;
-    size_t tail;
-    size_t count;
-    uint8_t *buffer;
-};
-/* clang-format on */
-
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
@@ -38,34 +30,147 @@ struct sRingBufferDesc {
  * Prototypes of private functions
  *********************************************************************************************************************/
 
+static size_t Ring_Buffer_RoundUpPowerOfTwo (size_t value);
+static void Ring_Buffer_SplitSpans (RingBuffer_Handle ring_buffer, const size_t position, const size_t size, sRingBufferSpan_t *first, sRingBufferSpan_t *second);
+static size_t Ring_Buffer_GetFreeSpace (RingBuffer_Handle ring_buffer);
+static size_t Ring_Buffer_MakeSpace (RingBuffer_Handle ring_buffer, const size_t size);
+static bool Ring_Buffer_AdvanceHead (RingBuffer_Handle ring_buffer, const size_t size);
+static bool Ring_Buffer_AdvanceTail (RingBuffer_Handle ring_buffer, size_t tail, const size_t size);
+static bool Ring_Buffer_ReadSpans (RingBuffer_Handle ring_buffer, size_t *tail, sRingBufferSpan_t *first, sRingBufferSpan_t *second);
+
 /**********************************************************************************************************************
  * Definitions of private functions
  *********************************************************************************************************************/
 
+static size_t Ring_Buffer_RoundUpPowerOfTwo (size_t value) {
+    size_t power = 1;
+
+    while (power < value) {
+        power <<= 1;
+    }
+
+    return power;
+}
+
+static void Ring_Buffer_SplitSpans (RingBuffer_Handle ring_buffer, const size_t position, const size_t size, sRingBufferSpan_t *first, sRingBufferSpan_t *second) {
+    size_t index = position & ring_buffer->mask;
+    size_t first_size = ring_buffer->buffer_capacity - index;
+
+    if (first_size > size) {
+        first_size = size;
+    }
+
+    first->data = &ring_buffer->buffer[index];
+    first->size = first_size;
+
+    if (NULL != second) {
+        second->data = ring_buffer->buffer;
+        second->size = size - first_size;
+    }
+
+    return;
+}
+
+static size_t Ring_Buffer_GetFreeSpace (RingBuffer_Handle ring_buffer) {
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+    return (ring_buffer->buffer_capacity - (head - tail));
+}
+
+/* Producer side of OverwriteOldest: moves tail forward until size bytes are free, returns discarded byte count */
+static size_t Ring_Buffer_MakeSpace (RingBuffer_Handle ring_buffer, const size_t size) {
+    size_t discarded = 0;
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+    while ((ring_buffer->buffer_capacity - (head - tail)) < size) {
+        size_t missing = size - (ring_buffer->buffer_capacity - (head - tail));
+
+        /* On failure tail is reloaded, the consumer may already have freed the space */
+        if (atomic_compare_exchange_weak_explicit(&ring_buffer->tail, &tail, tail + missing, memory_order_acq_rel, memory_order_acquire)) {
+            discarded += missing;
+            tail += missing;
+        }
+    }
+
+    return discarded;
+}
+
+static bool Ring_Buffer_AdvanceHead (RingBuffer_Handle ring_buffer, const size_t size) {
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+
+    if (size > (ring_buffer->buffer_capacity - (head - tail))) {
+        return false;
+    }
+
+    atomic_store_explicit(&ring_buffer->head, head + size, memory_order_release);
+
+    ring_buffer->stats.pushed += size;
+
+    if ((head + size - tail) > ring_buffer->stats.high_water_mark) {
+        ring_buffer->stats.high_water_mark = head + size - tail;
+    }
+
+    return true;
+}
+
+/* Consumer side: with OverwriteOldest the producer may move tail too, so the update must not lose its discard */
+static bool Ring_Buffer_AdvanceTail (RingBuffer_Handle ring_buffer, size_t tail, const size_t size) {
+    if (eRingBufferPolicy_OverwriteOldest != ring_buffer->policy) {
+        atomic_store_explicit(&ring_buffer->tail, tail + size, memory_order_release);
+
+        return true;
+    }
+
+    return atomic_compare_exchange_strong_explicit(&ring_buffer->tail, &tail, tail + size, memory_order_acq_rel, memory_order_relaxed);
+}
+
+static bool Ring_Buffer_ReadSpans (RingBuffer_Handle ring_buffer, size_t *tail, sRingBufferSpan_t *first, sRingBufferSpan_t *second) {
+    *tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_acquire);
+
+    Ring_Buffer_SplitSpans(ring_buffer, *tail, head - *tail, first, second);
+
+    return (0 != first->size);
+}
+
 /**********************************************************************************************************************
  * Definitions of exported functions
  *********************************************************************************************************************/
 
-RingBuffer_Handle Ring_Buffer_Init (size_t buffer_capacity) {
+RingBuffer_Handle Ring_Buffer_Init (size_t buffer_capacity, const eRingBufferPolicy_t policy) {
+    if (0 == buffer_capacity) {
+        return NULL;
+    }
+
+    if ((policy < eRingBufferPolicy_First) || (policy >= eRingBufferPolicy_Last)) {
+        return NULL;
+    }
+
     RingBuffer_Handle ring_buffer = malloc(sizeof(struct sRingBufferDesc));
 
     if (NULL == ring_buffer) {
-        free(ring_buffer);
         return NULL;
     }
 
-    ring_buffer->buffer_capacity = buffer_capacity;
+    ring_buffer->buffer_capacity = Ring_Buffer_RoundUpPowerOfTwo(buffer_capacity);
+    ring_buffer->mask = ring_buffer->buffer_capacity - 1;
 
-    ring_buffer->buffer = malloc(buffer_capacity);
+    ring_buffer->buffer = malloc(ring_buffer->buffer_capacity);
 
     if (NULL == ring_buffer->buffer) {
         free(ring_buffer);
         return NULL;
     }
 
-    ring_buffer->head = 0;
-    ring_buffer->tail = 0;
-    ring_buffer->count = 0;
+    atomic_init(&ring_buffer->head, 0);
+    atomic_init(&ring_buffer->tail, 0);
+
+    ring_buffer->policy = policy;
+    memset(&ring_buffer->stats, 0, sizeof(sRingBufferStats_t));
+    ring_buffer->is_static = false;
 
     return ring_buffer;
 }
@@ -75,6 +180,10 @@ bool Ring_Buffer_DeInit (RingBuffer_Handle ring_buffer) {
         return false;
     }
 
+    if (ring_buffer->is_static) {
+        return false;
+    }
+
     if (NULL == ring_buffer->buffer) {
         free(ring_buffer);
         return false;
@@ -87,7 +196,7 @@ bool Ring_Buffer_DeInit (RingBuffer_Handle ring_buffer) {
 
 bool Ring_Buffer_IsFull (RingBuffer_Handle ring_buffer) {
     if (NULL != ring_buffer) {
-        return (ring_buffer->count == ring_buffer->buffer_capacity);
+        return (Ring_Buffer_GetCount(ring_buffer) == ring_buffer->buffer_capacity);
     }
 
     return false;
@@ -95,54 +204,203 @@ bool Ring_Buffer_IsFull (RingBuffer_Handle ring_buffer) {
 
 bool Ring_Buffer_IsEmpty (RingBuffer_Handle ring_buffer) {
     if (NULL != ring_buffer) {
-        return (0 == ring_buffer->count);
+        return (0 == Ring_Buffer_GetCount(ring_buffer));
     }
 
     return false;
 }
 
-bool Ring_Buffer_Push (RingBuffer_Handle ring_buffer, uint8_t data) {
+size_t Ring_Buffer_GetCount (RingBuffer_Handle ring_buffer) {
     if (NULL == ring_buffer) {
-        return false;
+        return 0;
     }
-    
-    ring_buffer->buffer[ring_buffer->head] = data;
-    ring_buffer->head++;
 
-    if (ring_buffer->count < ring_buffer->buffer_capacity) {
-        ring_buffer->count++;
-    }
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_acquire);
+
+    return (head - tail);
+}
 
-    if (ring_buffer->buffer_capacity == ring_buffer->head) {
-        ring_buffer->head = 0;
+/* Whole storage area, for writers such as circular DMA that fill it on their own and publish with Commit */
+bool Ring_Buffer_GetStorage (RingBuffer_Handle ring_buffer, sRingBufferSpan_t *storage) {
+    if ((NULL == ring_buffer) || (NULL == storage)) {
+        return false;
     }
 
-    if (Ring_Buffer_IsFull(ring_buffer)) {
-        ring_buffer->tail = ring_buffer->head;
+    storage->data = ring_buffer->buffer;
+    storage->size = ring_buffer->buffer_capacity;
+
+    return true;
+}
+
+bool Ring_Buffer_GetStats (RingBuffer_Handle ring_buffer, sRingBufferStats_t *stats) {
+    if ((NULL == ring_buffer) || (NULL == stats)) {
+        return false;
     }
-    
+
+    *stats = ring_buffer->stats;
+
     return true;
 }
 
+bool Ring_Buffer_Push (RingBuffer_Handle ring_buffer, uint8_t data) {
+    return (1 == Ring_Buffer_PushBulk(ring_buffer, &data, 1));
+}
+
 bool Ring_Buffer_Pop (RingBuffer_Handle ring_buffer, uint8_t *data) {
-    if ((NULL == ring_buffer) || (NULL == data)) {
+    return (1 == Ring_Buffer_PopBulk(ring_buffer, data, 1));
+}
+
+size_t Ring_Buffer_PushBulk (RingBuffer_Handle ring_buffer, const uint8_t *data, const size_t size) {
+    if ((NULL == ring_buffer) || (NULL == data) || (0 == size)) {
+        return 0;
+    }
+
+    const uint8_t *source = data;
+    size_t count = size;
+    size_t free_space = Ring_Buffer_GetFreeSpace(ring_buffer);
+
+    if (count > free_space) {
+        switch (ring_buffer->policy) {
+            case eRingBufferPolicy_DropNewest: {
+                ring_buffer->stats.dropped += count - free_space;
+                count = free_space;
+            } break;
+            case eRingBufferPolicy_OverwriteOldest: {
+                if (count > ring_buffer->buffer_capacity) {
+                    ring_buffer->stats.dropped += count - ring_buffer->buffer_capacity;
+                    source += count - ring_buffer->buffer_capacity;
+                    count = ring_buffer->buffer_capacity;
+                }
+
+                ring_buffer->stats.dropped += Ring_Buffer_MakeSpace(ring_buffer, count);
+            } break;
+            case eRingBufferPolicy_Reject: {
+                ring_buffer->stats.rejected += count;
+            } return 0;
+            default: {
+            } return 0;
+        }
+    }
+
+    if (0 == count) {
+        return 0;
+    }
+
+    sRingBufferSpan_t first = {0};
+    sRingBufferSpan_t second = {0};
+
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+
+    Ring_Buffer_SplitSpans(ring_buffer, head, count, &first, &second);
+
+    memcpy(first.data, source, first.size);
+    memcpy(second.data, &source[first.size], second.size);
+
+    Ring_Buffer_AdvanceHead(ring_buffer, count);
+
+    return count;
+}
+
+size_t Ring_Buffer_PopBulk (RingBuffer_Handle ring_buffer, uint8_t *data, const size_t size) {
+    if ((NULL == ring_buffer) || (NULL == data) || (0 == size)) {
+        return 0;
+    }
+
+    size_t tail = 0;
+    size_t count = 0;
+    sRingBufferSpan_t first = {0};
+    sRingBufferSpan_t second = {0};
+
+    do {
+        if (!Ring_Buffer_ReadSpans(ring_buffer, &tail, &first, &second)) {
+            return 0;
+        }
+
+        size_t first_count = (size < first.size) ? size : first.size;
+        size_t second_count = ((size - first_count) < second.size) ? (size - first_count) : second.size;
+
+        memcpy(data, first.data, first_count);
+        memcpy(&data[first_count], second.data, second_count);
+
+        count = first_count + second_count;
+    } while (!Ring_Buffer_AdvanceTail(ring_buffer, tail, count));
+
+    return count;
+}
+
+bool Ring_Buffer_Reserve (RingBuffer_Handle ring_buffer, sRingBufferSpan_t *first, sRingBufferSpan_t *second) {
+    if ((NULL == ring_buffer) || (NULL == first)) {
         return false;
     }
 
-    if (Ring_Buffer_IsEmpty(ring_buffer)) {
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_relaxed);
+
+    Ring_Buffer_SplitSpans(ring_buffer, head, Ring_Buffer_GetFreeSpace(ring_buffer), first, second);
+
+    return (0 != first->size);
+}
+
+/* With OverwriteOldest a commit larger than the free space discards the oldest unread bytes */
+bool Ring_Buffer_Commit (RingBuffer_Handle ring_buffer, const size_t size) {
+    if (NULL == ring_buffer) {
         return false;
     }
 
-    *data = ring_buffer->buffer[ring_buffer->tail];
-    ring_buffer->tail++;
+    if ((eRingBufferPolicy_OverwriteOldest == ring_buffer->policy) && (size <= ring_buffer->buffer_capacity)) {
+        ring_buffer->stats.dropped += Ring_Buffer_MakeSpace(ring_buffer, size);
+    }
+
+    return Ring_Buffer_AdvanceHead(ring_buffer, size);
+}
 
-    if (ring_buffer->count > 0) {
-        ring_buffer->count--;
+bool Ring_Buffer_Peek (RingBuffer_Handle ring_buffer, sRingBufferSpan_t *first, sRingBufferSpan_t *second) {
+    if ((NULL == ring_buffer) || (NULL == first)) {
+        return false;
     }
 
-    if (ring_buffer->buffer_capacity == ring_buffer->tail) {
-        ring_buffer->tail = 0;
+    size_t tail = 0;
+
+    return Ring_Buffer_ReadSpans(ring_buffer, &tail, first, second);
+}
+
+/* With OverwriteOldest the producer may overwrite peeked bytes, zero-copy readers use PeekTail and ConsumeFrom */
+bool Ring_Buffer_Consume (RingBuffer_Handle ring_buffer, const size_t size) {
+    if (NULL == ring_buffer) {
+        return false;
     }
 
-    return true;
+    size_t tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_acquire);
+
+    if (size > (head - tail)) {
+        return false;
+    }
+
+    return Ring_Buffer_AdvanceTail(ring_buffer, tail, size);
+}
+
+/* Peek that also returns the free-running tail the spans start at, to be handed back to ConsumeFrom */
+bool Ring_Buffer_PeekTail (RingBuffer_Handle ring_buffer, size_t *tail, sRingBufferSpan_t *first, sRingBufferSpan_t *second) {
+    if ((NULL == ring_buffer) || (NULL == tail) || (NULL == first)) {
+        return false;
+    }
+
+    return Ring_Buffer_ReadSpans(ring_buffer, tail, first, second);
+}
+
+/* Fails when the tail is no longer the peeked one, with OverwriteOldest that means the peeked bytes were overwritten */
+bool Ring_Buffer_ConsumeFrom (RingBuffer_Handle ring_buffer, const size_t tail, const size_t size) {
+    if (NULL == ring_buffer) {
+        return false;
+    }
+
+    size_t current_tail = atomic_load_explicit(&ring_buffer->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring_buffer->head, memory_order_acquire);
+
+    if ((tail != current_tail) || (size > (head - tail))) {
+        return false;
+    }
+
+    return Ring_Buffer_AdvanceTail(ring_buffer, tail, size);
 }
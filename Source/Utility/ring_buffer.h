@@ -8,17 +8,74 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <stdatomic.h>
 
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
 
+#define RING_BUFFER_IS_POWER_OF_TWO(capacity) (((capacity) > 0) && (0 == ((capacity) & ((capacity) - 1))))
+
+/* Defines a statically allocated ring buffer, use &name as RingBuffer_Handle; no Ring_Buffer_Init call needed */
+#define RING_BUFFER_DEFINE(name, capacity, overrun_policy) \
+    _Static_assert(RING_BUFFER_IS_POWER_OF_TWO(capacity), #name ": ring buffer capacity must be a power of two"); \
+    static uint8_t name##_storage[(capacity)]; \
+    static struct sRingBufferDesc name = { \
+        .buffer_capacity = (capacity), \
+        .mask = (capacity) - 1, \
+        .head = 0, \
+        .tail = 0, \
+        .buffer = name##_storage, \
+        .policy = (overrun_policy), \
+        .stats = {0}, \
+        .is_static = true \
+    };
+
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
 
+/* clang-format off */
+typedef enum eRingBufferPolicy {
+    eRingBufferPolicy_First = 0,
+    eRingBufferPolicy_DropNewest = eRingBufferPolicy_First,    // Store what fits, discard the rest
+    eRingBufferPolicy_OverwriteOldest,                          // Always store, discard oldest unread bytes
+    eRingBufferPolicy_Reject,                                   // Store all or nothing, caller keeps the data
+    eRingBufferPolicy_Last
+} eRingBufferPolicy_t;
+
+/* Updated by the producer only; read with Ring_Buffer_GetStats */
+typedef struct sRingBufferStats {
+    size_t pushed;
+    size_t dropped;
+    size_t rejected;
+    size_t high_water_mark;
+} sRingBufferStats_t;
+
+/* Single-producer/single-consumer byte ring; capacity is rounded up to a power of two */
+/* Fields are exposed only so RING_BUFFER_DEFINE can allocate statically, use the API to access them */
+struct sRingBufferDesc {
+    size_t buffer_capacity;
+    size_t mask;
+    atomic_size_t head;     // Written by producer only, free running
+    atomic_size_t tail;     // Written by consumer, and by producer with OverwriteOldest policy, free running
+    uint8_t *buffer;
+    eRingBufferPolicy_t policy;
+    sRingBufferStats_t stats;
+    bool is_static;
+};
+/* clang-format on */
+
 typedef struct sRingBufferDesc *RingBuffer_Handle;
 
+/* Contiguous region inside ring storage, returned by Reserve/Peek */
+/* clang-format off */
+typedef struct sRingBufferSpan {
+    uint8_t *data;
+    size_t size;
+} sRingBufferSpan_t;
+/* clang-format on */
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -27,11 +84,22 @@ typedef struct sRingBufferDesc *RingBuffer_Handle;
  * Prototypes of exported functions
  *********************************************************************************************************************/
 
-RingBuffer_Handle Ring_Buffer_Init (size_t buffer_capacity);
+RingBuffer_Handle Ring_Buffer_Init (size_t buffer_capacity, const eRingBufferPolicy_t policy);
 bool Ring_Buffer_DeInit (RingBuffer_Handle ring_buffer);
 bool Ring_Buffer_IsFull (RingBuffer_Handle ring_buffer);
 bool Ring_Buffer_IsEmpty (RingBuffer_Handle ring_buffer);
+size_t Ring_Buffer_GetCount (RingBuffer_Handle ring_buffer);
+bool Ring_Buffer_GetStorage (RingBuffer_Handle ring_buffer, sRingBufferSpan_t *storage);
+bool Ring_Buffer_GetStats (RingBuffer_Handle ring_buffer, sRingBufferStats_t *stats);
 bool Ring_Buffer_Push (RingBuffer_Handle ring_buffer, uint8_t data);
 bool Ring_Buffer_Pop (RingBuffer_Handle ring_buffer, uint8_t *data);
+size_t Ring_Buffer_PushBulk (RingBuffer_Handle ring_buffer, const uint8_t *data, const size_t size);
+size_t Ring_Buffer_PopBulk (RingBuffer_Handle ring_buffer, uint8_t *data, const size_t size);
+bool Ring_Buffer_Reserve (RingBuffer_Handle ring_buffer, sRingBufferSpan_t *first, sRingBufferSpan_t *second);
+bool Ring_Buffer_Commit (RingBuffer_Handle ring_buffer, const size_t size);
+bool Ring_Buffer_Peek (RingBuffer_Handle ring_buffer, sRingBufferSpan_t *first, sRingBufferSpan_t *second);
+bool Ring_Buffer_Consume (RingBuffer_Handle ring_buffer, const size_t size);
+bool Ring_Buffer_PeekTail (RingBuffer_Handle ring_buffer, size_t *tail, sRingBufferSpan_t *first, sRingBufferSpan_t *second);
+bool Ring_Buffer_ConsumeFrom (RingBuffer_Handle ring_buffer, const size_t tail, const size_t size);
 
 #endif /* SOURCE_UTILITY_RING_BUFFER_H_ */
@@ -0,0 +1,396 @@
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include "tlsf.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/* Every first level range is split into 2^TLSF_SL_INDEX_COUNT_LOG2 linear second level lists */
+#define TLSF_SL_INDEX_COUNT_LOG2 4U
+#define TLSF_SL_INDEX_COUNT (1U << TLSF_SL_INDEX_COUNT_LOG2)
+
+/* Blocks below TLSF_SMALL_BLOCK_SIZE all share first level 0, spaced TLSF_ALIGNMENT bytes apart */
+#define TLSF_FL_INDEX_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + 3U)
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1U)
+#define TLSF_SMALL_BLOCK_SIZE (1U << TLSF_FL_INDEX_SHIFT)
+
+/* The header is the physical neighbour link and the size, free blocks keep their list links in the payload */
+#define TLSF_BLOCK_OVERHEAD offsetof(sTlsfBlock_t, next_free)
+#define TLSF_BLOCK_SIZE_MIN (sizeof(sTlsfBlock_t) - TLSF_BLOCK_OVERHEAD)
+#define TLSF_BLOCK_SIZE_MAX (((size_t) 1U << TLSF_FL_INDEX_MAX) - TLSF_ALIGNMENT)
+
+/* Payload sizes are multiples of TLSF_ALIGNMENT, the low bit of the size field marks a free block */
+#define TLSF_BLOCK_FREE_BIT 1U
+#define TLSF_BLOCK_SIZE_MASK (~(size_t) (TLSF_ALIGNMENT - 1U))
+
+#define TLSF_ALIGN_UP(value) (((value) + (TLSF_ALIGNMENT - 1U)) & ~((uintptr_t) TLSF_ALIGNMENT - 1U))
+#define TLSF_ALIGN_DOWN(value) ((value) & ~((uintptr_t) TLSF_ALIGNMENT - 1U))
+
+_Static_assert(TLSF_FL_INDEX_COUNT <= 32U, "TLSF_FL_INDEX_MAX too large for a 32 bit first level bitmap");
+_Static_assert((1U << (TLSF_FL_INDEX_SHIFT - TLSF_SL_INDEX_COUNT_LOG2)) == TLSF_ALIGNMENT, "Small block classes must be TLSF_ALIGNMENT apart");
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef struct sTlsfBlock {
+    struct sTlsfBlock *prev_physical;
+    size_t size;
+    struct sTlsfBlock *next_free;
+    struct sTlsfBlock *prev_free;
+} sTlsfBlock_t;
+
+struct sTlsfDesc {
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[TLSF_FL_INDEX_COUNT];
+    sTlsfBlock_t *free_lists[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+    uint8_t *start;
+    uint8_t *end;
+    sTlsfStats_t stats;
+};
+/* clang-format on */
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables and references
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of private functions
+ *********************************************************************************************************************/
+
+static uint32_t Tlsf_FindLastSet (const size_t value);
+static void Tlsf_MappingInsert (const size_t size, uint32_t *fl, uint32_t *sl);
+static void Tlsf_MappingSearch (const size_t size, uint32_t *fl, uint32_t *sl);
+static size_t Tlsf_GetBlockSize (const sTlsfBlock_t *block);
+static bool Tlsf_IsBlockFree (const sTlsfBlock_t *block);
+static sTlsfBlock_t *Tlsf_GetNextPhysical (const sTlsfBlock_t *block);
+static void *Tlsf_BlockToPointer (const sTlsfBlock_t *block);
+static sTlsfBlock_t *Tlsf_PointerToBlock (const void *pointer_to_memory);
+static void Tlsf_InsertFreeBlock (Tlsf_Handle tlsf, sTlsfBlock_t *block);
+static void Tlsf_RemoveFreeBlock (Tlsf_Handle tlsf, sTlsfBlock_t *block);
+static sTlsfBlock_t *Tlsf_FindFreeBlock (Tlsf_Handle tlsf, const size_t size);
+static void Tlsf_SplitBlock (Tlsf_Handle tlsf, sTlsfBlock_t *block, const size_t size);
+static sTlsfBlock_t *Tlsf_MergeBlocks (sTlsfBlock_t *block, sTlsfBlock_t *next);
+
+/**********************************************************************************************************************
+ * Definitions of private functions
+ *********************************************************************************************************************/
+
+/* Index of the highest set bit, a single CLZ instruction on Cortex-M */
+static uint32_t Tlsf_FindLastSet (const size_t value) {
+    return (uint32_t) ((sizeof(unsigned long) * 8U) - 1U - (size_t) __builtin_clzl((unsigned long) value));
+}
+
+/* List a free block of this size belongs to */
+static void Tlsf_MappingInsert (const size_t size, uint32_t *fl, uint32_t *sl) {
+    if (size < TLSF_SMALL_BLOCK_SIZE) {
+        *fl = 0;
+        *sl = (uint32_t) (size / TLSF_ALIGNMENT);
+
+        return;
+    }
+
+    uint32_t last_bit = Tlsf_FindLastSet(size);
+
+    *sl = (uint32_t) (size >> (last_bit - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+    *fl = last_bit - (TLSF_FL_INDEX_SHIFT - 1U);
+
+    return;
+}
+
+/* First list whose every block fits the size, rounding up keeps the search a good fit without walking a list */
+static void Tlsf_MappingSearch (const size_t size, uint32_t *fl, uint32_t *sl) {
+    size_t rounded_size = size;
+
+    if (size >= TLSF_SMALL_BLOCK_SIZE) {
+        rounded_size += ((size_t) 1U << (Tlsf_FindLastSet(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1U;
+    }
+
+    Tlsf_MappingInsert(rounded_size, fl, sl);
+
+    return;
+}
+
+static size_t Tlsf_GetBlockSize (const sTlsfBlock_t *block) {
+    return block->size & TLSF_BLOCK_SIZE_MASK;
+}
+
+static bool Tlsf_IsBlockFree (const sTlsfBlock_t *block) {
+    return (0 != (block->size & TLSF_BLOCK_FREE_BIT));
+}
+
+static sTlsfBlock_t *Tlsf_GetNextPhysical (const sTlsfBlock_t *block) {
+    return (sTlsfBlock_t *) ((uint8_t *) Tlsf_BlockToPointer(block) + Tlsf_GetBlockSize(block));
+}
+
+static void *Tlsf_BlockToPointer (const sTlsfBlock_t *block) {
+    return (uint8_t *) block + TLSF_BLOCK_OVERHEAD;
+}
+
+static sTlsfBlock_t *Tlsf_PointerToBlock (const void *pointer_to_memory) {
+    return (sTlsfBlock_t *) ((uint8_t *) pointer_to_memory - TLSF_BLOCK_OVERHEAD);
+}
+
+static void Tlsf_InsertFreeBlock (Tlsf_Handle tlsf, sTlsfBlock_t *block) {
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+
+    Tlsf_MappingInsert(Tlsf_GetBlockSize(block), &fl, &sl);
+
+    block->size |= TLSF_BLOCK_FREE_BIT;
+    block->prev_free = NULL;
+    block->next_free = tlsf->free_lists[fl][sl];
+
+    if (NULL != block->next_free) {
+        block->next_free->prev_free = block;
+    }
+
+    tlsf->free_lists[fl][sl] = block;
+    tlsf->fl_bitmap |= (1UL << fl);
+    tlsf->sl_bitmap[fl] |= (1UL << sl);
+
+    return;
+}
+
+static void Tlsf_RemoveFreeBlock (Tlsf_Handle tlsf, sTlsfBlock_t *block) {
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+
+    Tlsf_MappingInsert(Tlsf_GetBlockSize(block), &fl, &sl);
+
+    if (NULL != block->next_free) {
+        block->next_free->prev_free = block->prev_free;
+    }
+
+    if (NULL != block->prev_free) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        tlsf->free_lists[fl][sl] = block->next_free;
+    }
+
+    if (NULL == tlsf->free_lists[fl][sl]) {
+        tlsf->sl_bitmap[fl] &= ~(1UL << sl);
+
+        if (0 == tlsf->sl_bitmap[fl]) {
+            tlsf->fl_bitmap &= ~(1UL << fl);
+        }
+    }
+
+    block->size &= ~(size_t) TLSF_BLOCK_FREE_BIT;
+
+    return;
+}
+
+/* Two bitmap scans instead of a list walk, this is what bounds the allocation time */
+static sTlsfBlock_t *Tlsf_FindFreeBlock (Tlsf_Handle tlsf, const size_t size) {
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+
+    Tlsf_MappingSearch(size, &fl, &sl);
+
+    if (fl >= TLSF_FL_INDEX_COUNT) {
+        return NULL;
+    }
+
+    uint32_t sl_map = tlsf->sl_bitmap[fl] & (~0UL << sl);
+
+    if (0 == sl_map) {
+        uint32_t fl_map = tlsf->fl_bitmap & (~0UL << (fl + 1U));
+
+        if (0 == fl_map) {
+            return NULL;
+        }
+
+        fl = (uint32_t) __builtin_ctz(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+
+    sl = (uint32_t) __builtin_ctz(sl_map);
+
+    return tlsf->free_lists[fl][sl];
+}
+
+/* Frees the tail past size when it can hold a block, free blocks never border each other so it needs no merging */
+static void Tlsf_SplitBlock (Tlsf_Handle tlsf, sTlsfBlock_t *block, const size_t size) {
+    size_t block_size = Tlsf_GetBlockSize(block);
+
+    if (block_size < (size + TLSF_BLOCK_OVERHEAD + TLSF_BLOCK_SIZE_MIN)) {
+        return;
+    }
+
+    block->size = size;
+
+    sTlsfBlock_t *remainder = Tlsf_GetNextPhysical(block);
+
+    remainder->prev_physical = block;
+    remainder->size = block_size - size - TLSF_BLOCK_OVERHEAD;
+    Tlsf_GetNextPhysical(remainder)->prev_physical = remainder;
+
+    Tlsf_InsertFreeBlock(tlsf, remainder);
+
+    return;
+}
+
+/* Absorbs next, which must follow block physically and be out of the free lists */
+static sTlsfBlock_t *Tlsf_MergeBlocks (sTlsfBlock_t *block, sTlsfBlock_t *next) {
+    block->size += Tlsf_GetBlockSize(next) + TLSF_BLOCK_OVERHEAD;
+    Tlsf_GetNextPhysical(block)->prev_physical = block;
+
+    return block;
+}
+
+/**********************************************************************************************************************
+ * Definitions of exported functions
+ *********************************************************************************************************************/
+
+/* Places the control structure at the start of the region and turns the rest into a single free block */
+Tlsf_Handle Tlsf_Init (void *memory, const size_t size) {
+    if (NULL == memory) {
+        return NULL;
+    }
+
+    uintptr_t start = TLSF_ALIGN_UP((uintptr_t) memory);
+    uintptr_t end = TLSF_ALIGN_DOWN((uintptr_t) memory + size);
+    uintptr_t first_block = start + TLSF_ALIGN_UP(sizeof(struct sTlsfDesc));
+
+    if ((end < first_block) || ((end - first_block) < ((2U * TLSF_BLOCK_OVERHEAD) + TLSF_BLOCK_SIZE_MIN))) {
+        return NULL;
+    }
+
+    size_t block_size = (end - first_block) - (2U * TLSF_BLOCK_OVERHEAD);
+
+    if (block_size > TLSF_BLOCK_SIZE_MAX) {
+        block_size = TLSF_BLOCK_SIZE_MAX;
+    }
+
+    Tlsf_Handle tlsf = (Tlsf_Handle) start;
+
+    *tlsf = (struct sTlsfDesc) {0};
+
+    sTlsfBlock_t *block = (sTlsfBlock_t *) first_block;
+
+    block->prev_physical = NULL;
+    block->size = block_size;
+
+    /* A zero sized used block terminates the region so merging never looks past it */
+    sTlsfBlock_t *sentinel = Tlsf_GetNextPhysical(block);
+
+    sentinel->prev_physical = block;
+    sentinel->size = 0;
+
+    tlsf->start = (uint8_t *) block;
+    tlsf->end = (uint8_t *) sentinel;
+    tlsf->stats.total = block_size;
+
+    Tlsf_InsertFreeBlock(tlsf, block);
+
+    return tlsf;
+}
+
+void *Tlsf_Allocate (Tlsf_Handle tlsf, const size_t size) {
+    if (NULL == tlsf) {
+        return NULL;
+    }
+
+    if ((0 == size) || (size > TLSF_BLOCK_SIZE_MAX)) {
+        tlsf->stats.failed++;
+
+        return NULL;
+    }
+
+    size_t adjusted_size = TLSF_ALIGN_UP(size);
+
+    if (adjusted_size < TLSF_BLOCK_SIZE_MIN) {
+        adjusted_size = TLSF_BLOCK_SIZE_MIN;
+    }
+
+    sTlsfBlock_t *block = Tlsf_FindFreeBlock(tlsf, adjusted_size);
+
+    if (NULL == block) {
+        tlsf->stats.failed++;
+
+        return NULL;
+    }
+
+    Tlsf_RemoveFreeBlock(tlsf, block);
+    Tlsf_SplitBlock(tlsf, block, adjusted_size);
+
+    tlsf->stats.used += Tlsf_GetBlockSize(block) + TLSF_BLOCK_OVERHEAD;
+    tlsf->stats.block_count++;
+
+    if (tlsf->stats.used > tlsf->stats.peak_used) {
+        tlsf->stats.peak_used = tlsf->stats.used;
+    }
+
+    return Tlsf_BlockToPointer(block);
+}
+
+/* Coalesces with both physical neighbours, pointers outside the region and blocks still on a free list are rejected */
+bool Tlsf_Free (Tlsf_Handle tlsf, void *pointer_to_memory) {
+    if (!Tlsf_IsOwner(tlsf, pointer_to_memory)) {
+        return false;
+    }
+
+    sTlsfBlock_t *block = Tlsf_PointerToBlock(pointer_to_memory);
+
+    if (Tlsf_IsBlockFree(block)) {
+        return false;
+    }
+
+    tlsf->stats.used -= Tlsf_GetBlockSize(block) + TLSF_BLOCK_OVERHEAD;
+    tlsf->stats.block_count--;
+
+    sTlsfBlock_t *previous = block->prev_physical;
+
+    if ((NULL != previous) && Tlsf_IsBlockFree(previous)) {
+        Tlsf_RemoveFreeBlock(tlsf, previous);
+        block = Tlsf_MergeBlocks(previous, block);
+    }
+
+    sTlsfBlock_t *next = Tlsf_GetNextPhysical(block);
+
+    if (Tlsf_IsBlockFree(next)) {
+        Tlsf_RemoveFreeBlock(tlsf, next);
+        block = Tlsf_MergeBlocks(block, next);
+    }
+
+    Tlsf_InsertFreeBlock(tlsf, block);
+
+    return true;
+}
+
+bool Tlsf_IsOwner (Tlsf_Handle tlsf, const void *pointer_to_memory) {
+    if ((NULL == tlsf) || (NULL == pointer_to_memory)) {
+        return false;
+    }
+
+    const uint8_t *pointer = (const uint8_t *) pointer_to_memory;
+
+    if ((pointer < (tlsf->start + TLSF_BLOCK_OVERHEAD)) || (pointer >= tlsf->end)) {
+        return false;
+    }
+
+    return (0 == ((uintptr_t) pointer & (TLSF_ALIGNMENT - 1U)));
+}
+
+bool Tlsf_GetStats (Tlsf_Handle tlsf, sTlsfStats_t *stats) {
+    if ((NULL == tlsf) || (NULL == stats)) {
+        return false;
+    }
+
+    *stats = tlsf->stats;
+
+    return true;
+}
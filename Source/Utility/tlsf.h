@@ -0,0 +1,52 @@
+#ifndef SOURCE_UTILITY_TLSF_H_
+#define SOURCE_UTILITY_TLSF_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/* Every payload is aligned to and rounded up to TLSF_ALIGNMENT bytes */
+#define TLSF_ALIGNMENT 8U
+
+/* Largest block is 2^TLSF_FL_INDEX_MAX bytes, memory past that in the region is left unused */
+#define TLSF_FL_INDEX_MAX 18U
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/* clang-format off */
+typedef struct sTlsfStats {
+    size_t total;
+    size_t used;
+    size_t peak_used;
+    size_t block_count;
+    uint32_t failed;
+} sTlsfStats_t;
+/* clang-format on */
+
+/* The control structure lives at the start of the region passed to Tlsf_Init */
+typedef struct sTlsfDesc *Tlsf_Handle;
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+Tlsf_Handle Tlsf_Init (void *memory, const size_t size);
+void *Tlsf_Allocate (Tlsf_Handle tlsf, const size_t size);
+bool Tlsf_Free (Tlsf_Handle tlsf, void *pointer_to_memory);
+bool Tlsf_IsOwner (Tlsf_Handle tlsf, const void *pointer_to_memory);
+bool Tlsf_GetStats (Tlsf_Handle tlsf, sTlsfStats_t *stats);
+
+#endif /* SOURCE_UTILITY_TLSF_H_ */
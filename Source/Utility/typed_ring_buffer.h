@@ -0,0 +1,96 @@
+#ifndef SOURCE_UTILITY_TYPED_RING_BUFFER_H_
+#define SOURCE_UTILITY_TYPED_RING_BUFFER_H_
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "ring_buffer.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/* SPSC ring of fixed-size records, defines Name_t and static inline Name_Reset/GetCount/Push/Pop/Peek/PushBulk/PopBulk */
+/* Capacity must be a power of two, pushes that do not fit are dropped, instances need no init (static Name_t g_ring = {0};) */
+#define TYPED_RING_BUFFER_DEFINE(name, type, capacity) \
+    _Static_assert(RING_BUFFER_IS_POWER_OF_TWO(capacity), #name ": ring buffer capacity must be a power of two"); \
+    \
+    typedef struct name##_Desc { \
+        atomic_size_t head; \
+        atomic_size_t tail; \
+        type buffer[(capacity)]; \
+    } name##_t; \
+    \
+    static inline void name##_Reset (name##_t *ring) { \
+        atomic_store_explicit(&ring->head, 0, memory_order_relaxed); \
+        atomic_store_explicit(&ring->tail, 0, memory_order_release); \
+    } \
+    \
+    static inline size_t name##_GetCount (name##_t *ring) { \
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire); \
+        size_t head = atomic_load_explicit(&ring->head, memory_order_acquire); \
+        return (head - tail); \
+    } \
+    \
+    static inline size_t name##_PushBulk (name##_t *ring, const type *elements, const size_t count) { \
+        size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed); \
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire); \
+        size_t free_space = (capacity) - (head - tail); \
+        size_t to_copy = (count < free_space) ? count : free_space; \
+        size_t index = head & ((capacity) - 1); \
+        size_t first_count = ((to_copy) < ((capacity) - index)) ? to_copy : ((capacity) - index); \
+        memcpy(&ring->buffer[index], elements, first_count * sizeof(type)); \
+        memcpy(ring->buffer, &elements[first_count], (to_copy - first_count) * sizeof(type)); \
+        atomic_store_explicit(&ring->head, head + to_copy, memory_order_release); \
+        return to_copy; \
+    } \
+    \
+    static inline size_t name##_PopBulk (name##_t *ring, type *elements, const size_t count) { \
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed); \
+        size_t head = atomic_load_explicit(&ring->head, memory_order_acquire); \
+        size_t available = head - tail; \
+        size_t to_copy = (count < available) ? count : available; \
+        size_t index = tail & ((capacity) - 1); \
+        size_t first_count = ((to_copy) < ((capacity) - index)) ? to_copy : ((capacity) - index); \
+        memcpy(elements, &ring->buffer[index], first_count * sizeof(type)); \
+        memcpy(&elements[first_count], ring->buffer, (to_copy - first_count) * sizeof(type)); \
+        atomic_store_explicit(&ring->tail, tail + to_copy, memory_order_release); \
+        return to_copy; \
+    } \
+    \
+    static inline bool name##_Push (name##_t *ring, const type *element) { \
+        return (1 == name##_PushBulk(ring, element, 1)); \
+    } \
+    \
+    static inline bool name##_Pop (name##_t *ring, type *element) { \
+        return (1 == name##_PopBulk(ring, element, 1)); \
+    } \
+    \
+    static inline bool name##_Peek (name##_t *ring, type *element) { \
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed); \
+        size_t head = atomic_load_explicit(&ring->head, memory_order_acquire); \
+        if (head == tail) { \
+            return false; \
+        } \
+        *element = ring->buffer[tail & ((capacity) - 1)]; \
+        return true; \
+    }
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+
+#endif /* SOURCE_UTILITY_TYPED_RING_BUFFER_H_ */
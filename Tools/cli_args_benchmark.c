@@ -0,0 +1,192 @@
+/*
+ * Host benchmark of the CLI argument tokenizer (CMD_API_Helper_Tokenize and the GetArg accessors in
+ * Source/API/cmd_api_helper.c) against the CMD_API_Helper_FindNextArg chain the handlers used before.
+ *
+ * Each case is the argument part of a command line the default handlers take, parsed the way the handler does it.
+ * Both parsers must return the same values, then the time per command line is reported. The line is copied into
+ * a fresh buffer on every iteration for both parsers, since both write '\0' over the separators.
+ *
+ *     gcc -O2 -I Source/API -I Source/Utility -DPROJECT_CONFIG_H='"example_config.h"' Tools/cli_args_benchmark.c \
+ *         Source/API/cmd_api_helper.c Source/Utility/format.c -lm -o cli_args_benchmark
+ *     ./cli_args_benchmark
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cmd_api_helper.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define READ_CYCLES() __rdtsc()
+#else
+#define READ_CYCLES() 0ULL
+#endif /* __x86_64__ || __i386__ */
+
+#define BENCHMARK_ITERATIONS 1000000U
+#define BENCHMARK_BUFFER_SIZE 64U
+#define BENCHMARK_RESPONSE_SIZE 128U
+
+/* 'u' is an unsigned argument, 'f' a float, one character per argument in order */
+typedef struct sBenchmarkCase {
+    const char *name;
+    const char *line;
+    const char *types;
+} sBenchmarkCase_t;
+
+typedef struct sBenchmarkValues {
+    size_t count;
+    size_t integer[CMD_API_HELPER_MAX_ARGS];
+    float real[CMD_API_HELPER_MAX_ARGS];
+} sBenchmarkValues_t;
+
+typedef eErrorCode_t (*Parser_t) (const sBenchmarkCase_t *benchmark_case, char *buffer, sBenchmarkValues_t *values);
+
+static const sBenchmarkCase_t g_benchmark_cases[] = {
+    {.name = "led_set", .line = "2", .types = "u"},
+    {.name = "led_blink", .line = "1,1000,5", .types = "uuu"},
+    {.name = "motors_set", .line = "800,1,0", .types = "uuu"},
+    {.name = "rgb", .line = "255,128,0", .types = "uuu"},
+    {.name = "motors_setrpm", .line = "0,1,120.5", .types = "uuf"},
+    {.name = "motors_setpid", .line = "1,0.8125,0.0312,0.0015,250.0", .types = "uffff"},
+    {.name = "eight args", .line = "1,22,333,4444,55555,666666,7777777,88888888", .types = "uuuuuuuu"},
+};
+
+static char g_response_buffer[BENCHMARK_RESPONSE_SIZE];
+static sMessage_t g_response = {.data = g_response_buffer, .size = BENCHMARK_RESPONSE_SIZE};
+
+static eErrorCode_t Benchmark_FindNextArg (const sBenchmarkCase_t *benchmark_case, char *buffer, sBenchmarkValues_t *values) {
+    sMessage_t arguments = {.data = buffer, .size = strlen(buffer)};
+    eErrorCode_t error = eErrorCode_OK;
+
+    values->count = 0;
+
+    for (const char *type = benchmark_case->types; '\0' != *type; type++) {
+        if ('f' == *type) {
+            error = CMD_API_Helper_FindNextArgFloat(&arguments, &values->real[values->count], CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, &g_response);
+        } else {
+            error = CMD_API_Helper_FindNextArgUInt(&arguments, &values->integer[values->count], CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, &g_response);
+        }
+
+        if (eErrorCode_OK != error) {
+            return error;
+        }
+
+        values->count++;
+    }
+
+    return (0 != arguments.size) ? eErrorCode_ARGMANY : eErrorCode_OK;
+}
+
+static eErrorCode_t Benchmark_Tokenize (const sBenchmarkCase_t *benchmark_case, char *buffer, sBenchmarkValues_t *values) {
+    sMessage_t arguments = {.data = buffer, .size = strlen(buffer)};
+    sCmdArgs_t args = {0};
+
+    values->count = 0;
+
+    eErrorCode_t error = CMD_API_Helper_Tokenize(arguments, &args, CMD_SEPARATOR, CMD_SEPARATOR_LENGTH, &g_response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    error = CMD_API_Helper_CheckArgCount(&args, strlen(benchmark_case->types), &g_response);
+
+    if (eErrorCode_OK != error) {
+        return error;
+    }
+
+    for (const char *type = benchmark_case->types; '\0' != *type; type++) {
+        if ('f' == *type) {
+            error = CMD_API_Helper_GetArgFloat(&args, values->count, &values->real[values->count], &g_response);
+        } else {
+            error = CMD_API_Helper_GetArgUInt(&args, values->count, &values->integer[values->count], &g_response);
+        }
+
+        if (eErrorCode_OK != error) {
+            return error;
+        }
+
+        values->count++;
+    }
+
+    return eErrorCode_OK;
+}
+
+static bool Benchmark_Check (const sBenchmarkCase_t *benchmark_case) {
+    char buffer[BENCHMARK_BUFFER_SIZE];
+    sBenchmarkValues_t expected = {0};
+    sBenchmarkValues_t actual = {0};
+
+    strcpy(buffer, benchmark_case->line);
+    eErrorCode_t expected_error = Benchmark_FindNextArg(benchmark_case, buffer, &expected);
+
+    strcpy(buffer, benchmark_case->line);
+    eErrorCode_t actual_error = Benchmark_Tokenize(benchmark_case, buffer, &actual);
+
+    if ((eErrorCode_OK != expected_error) || (eErrorCode_OK != actual_error) || (expected.count != actual.count)) {
+        printf("mismatch in %s: errors %d and %d, %zu and %zu arguments\n", benchmark_case->name, expected_error, actual_error, expected.count, actual.count);
+
+        return false;
+    }
+
+    if ((0 != memcmp(expected.integer, actual.integer, sizeof(expected.integer))) || (0 != memcmp(expected.real, actual.real, sizeof(expected.real)))) {
+        printf("mismatch in %s: different values\n", benchmark_case->name);
+
+        return false;
+    }
+
+    return true;
+}
+
+static double Benchmark_MeasureTime (const sBenchmarkCase_t *benchmark_case, Parser_t parser, uint64_t *cycles) {
+    char buffer[BENCHMARK_BUFFER_SIZE];
+    sBenchmarkValues_t values = {0};
+    size_t line_size = strlen(benchmark_case->line) + 1;
+    struct timespec start;
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t cycles_start = READ_CYCLES();
+
+    for (uint32_t iteration = 0; iteration < BENCHMARK_ITERATIONS; iteration++) {
+        memcpy(buffer, benchmark_case->line, line_size);
+        parser(benchmark_case, buffer, &values);
+        __asm__ volatile("" : : "r"(&values) : "memory");
+    }
+
+    *cycles = (READ_CYCLES() - cycles_start) / BENCHMARK_ITERATIONS;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double elapsed_ns = ((double) (end.tv_sec - start.tv_sec) * 1e9) + (double) (end.tv_nsec - start.tv_nsec);
+
+    return elapsed_ns / BENCHMARK_ITERATIONS;
+}
+
+int main (void) {
+    bool is_matching = true;
+
+    printf("%-14s %12s %12s %10s %10s\n", "case", "findnext ns", "tokenize ns", "find cyc", "token cyc");
+
+    for (size_t index = 0; index < (sizeof(g_benchmark_cases) / sizeof(g_benchmark_cases[0])); index++) {
+        const sBenchmarkCase_t *benchmark_case = &g_benchmark_cases[index];
+
+        if (!Benchmark_Check(benchmark_case)) {
+            is_matching = false;
+
+            continue;
+        }
+
+        uint64_t find_cycles = 0;
+        uint64_t token_cycles = 0;
+        double find_ns = Benchmark_MeasureTime(benchmark_case, Benchmark_FindNextArg, &find_cycles);
+        double token_ns = Benchmark_MeasureTime(benchmark_case, Benchmark_Tokenize, &token_cycles);
+
+        printf("%-14s %12.1f %12.1f %10llu %10llu\n", benchmark_case->name, find_ns, token_ns, (unsigned long long) find_cycles, (unsigned long long) token_cycles);
+    }
+
+    return is_matching ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,192 @@
+/*
+ * Host benchmark of Format_VPrint (Source/Utility/format.c) against the C library vsnprintf.
+ *
+ * For every case it checks that both produce the same text, then reports the time per call and the deepest stack
+ * use. Each formatter runs on its own thread whose stack is painted with a pattern, the untouched part is counted
+ * afterwards. Figures are for the host, build the same file for the target to get the numbers for the MCU.
+ *
+ *     gcc -O2 -I Source/Utility Tools/format_benchmark.c Source/Utility/format.c -lm -lpthread -o format_benchmark
+ *     ./format_benchmark
+ */
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "format.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define READ_CYCLES() __rdtsc()
+#else
+#define READ_CYCLES() 0ULL
+#endif /* __x86_64__ || __i386__ */
+
+#define BENCHMARK_ITERATIONS 200000U
+#define BENCHMARK_STACK_SIZE (64U * 1024U)
+#define BENCHMARK_STACK_PATTERN 0xA5U
+#define BENCHMARK_BUFFER_SIZE 256U
+
+typedef size_t (*Formatter_t) (char *buffer, const size_t size, const char *format, va_list arguments);
+
+typedef struct sBenchmarkCase {
+    const char *name;
+    void (*run) (Formatter_t formatter, char *buffer, const size_t size);
+} sBenchmarkCase_t;
+
+typedef struct sBenchmarkJob {
+    const sBenchmarkCase_t *benchmark_case;
+    Formatter_t formatter;
+    uint32_t iterations;
+    char buffer[BENCHMARK_BUFFER_SIZE];
+} sBenchmarkJob_t;
+
+static size_t Benchmark_LibcFormat (char *buffer, const size_t size, const char *format, va_list arguments) {
+    int length = vsnprintf(buffer, size, format, arguments);
+
+    if (length < 0) {
+        return 0;
+    }
+
+    return ((size_t) length >= size) ? (size - 1) : (size_t) length;
+}
+
+static void Benchmark_Call (Formatter_t formatter, char *buffer, const size_t size, const char *format, ...) {
+    va_list arguments;
+
+    va_start(arguments, format);
+    formatter(buffer, size, format, arguments);
+    va_end(arguments);
+}
+
+/* The same lines the firmware prints most, a trace prefix, a trace body, a float and a CLI error response */
+static void Benchmark_TracePrefix (Formatter_t formatter, char *buffer, const size_t size) {
+    Benchmark_Call(formatter, buffer, size, "[%s.ERR] (file: %s, line: %u) ", "MOTOR_API", "Source/API/motor_api.c", 352U);
+}
+
+static void Benchmark_TraceBody (Formatter_t formatter, char *buffer, const size_t size) {
+    Benchmark_Call(formatter, buffer, size, "Motor [%d]: Target RPM: %ld, Current RPM: %ld, Speed: %u, Reg: 0x%04X\n", 1, 1200L, -1187L, 812U, 0xBEEFU);
+}
+
+static void Benchmark_Float (Formatter_t formatter, char *buffer, const size_t size) {
+    Benchmark_Call(formatter, buffer, size, "Kp: %.4f, Ki: %.4f, Kd: %.4f, speed: %.3f\n", 0.8125f, 0.0312f, -1.5f, 53.379f);
+}
+
+static void Benchmark_Response (Formatter_t formatter, char *buffer, const size_t size) {
+    Benchmark_Call(formatter, buffer, size, "[%s]: Invalid argument; Use digits separated by: '%s'\n", "12a", ",");
+}
+
+static void Benchmark_Wide (Formatter_t formatter, char *buffer, const size_t size) {
+    Benchmark_Call(formatter, buffer, size, "uptime: %llu us, offset: %lld, id: 0x%016llX, max: %jd\n", 123456789012ULL, INT64_MIN, 0xDEADBEEFCAFEULL, INTMAX_MAX);
+}
+
+static void Benchmark_Truncated (Formatter_t formatter, char *buffer, const size_t size) {
+    (void) size;
+
+    Benchmark_Call(formatter, buffer, 16, "%-8s|%6d|%c%%", "truncated line", -42, 'x');
+}
+
+static void Benchmark_Empty (Formatter_t formatter, char *buffer, const size_t size) {
+    (void) formatter;
+    (void) size;
+
+    buffer[0] = '\0';
+}
+
+static const sBenchmarkCase_t g_baseline_case = {.name = "baseline", .run = Benchmark_Empty};
+
+static const sBenchmarkCase_t g_benchmark_cases[] = {
+    {.name = "trace prefix", .run = Benchmark_TracePrefix},
+    {.name = "trace body", .run = Benchmark_TraceBody},
+    {.name = "float", .run = Benchmark_Float},
+    {.name = "cli response", .run = Benchmark_Response},
+    {.name = "64 bit", .run = Benchmark_Wide},
+    {.name = "truncated", .run = Benchmark_Truncated},
+};
+
+static void *Benchmark_StackProbe (void *arg) {
+    sBenchmarkJob_t *job = arg;
+
+    job->benchmark_case->run(job->formatter, job->buffer, sizeof(job->buffer));
+
+    return NULL;
+}
+
+/* Stack bytes touched by one call, measured on a freshly painted thread stack */
+static size_t Benchmark_MeasureStack (sBenchmarkJob_t *job) {
+    uint8_t *stack = aligned_alloc(4096U, BENCHMARK_STACK_SIZE);
+    pthread_attr_t attributes;
+    pthread_t thread;
+
+    memset(stack, BENCHMARK_STACK_PATTERN, BENCHMARK_STACK_SIZE);
+    pthread_attr_init(&attributes);
+    pthread_attr_setstack(&attributes, stack, BENCHMARK_STACK_SIZE);
+    pthread_create(&thread, &attributes, Benchmark_StackProbe, job);
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attributes);
+
+    size_t untouched = 0;
+
+    while ((untouched < BENCHMARK_STACK_SIZE) && (BENCHMARK_STACK_PATTERN == stack[untouched])) {
+        untouched++;
+    }
+
+    free(stack);
+
+    return BENCHMARK_STACK_SIZE - untouched;
+}
+
+static double Benchmark_MeasureTime (sBenchmarkJob_t *job, uint64_t *cycles) {
+    struct timespec start;
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t cycles_start = READ_CYCLES();
+
+    for (uint32_t iteration = 0; iteration < job->iterations; iteration++) {
+        job->benchmark_case->run(job->formatter, job->buffer, sizeof(job->buffer));
+        __asm__ volatile("" : : "r"(job->buffer) : "memory");
+    }
+
+    *cycles = (READ_CYCLES() - cycles_start) / job->iterations;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double elapsed_ns = ((double) (end.tv_sec - start.tv_sec) * 1e9) + (double) (end.tv_nsec - start.tv_nsec);
+
+    return elapsed_ns / job->iterations;
+}
+
+int main (void) {
+    /* Thread start up uses some stack too, it is measured with an empty job and subtracted */
+    sBenchmarkJob_t baseline_job = {.benchmark_case = &g_baseline_case, .formatter = Format_VPrint, .iterations = 1};
+    size_t baseline_stack = Benchmark_MeasureStack(&baseline_job);
+    bool is_matching = true;
+
+    printf("%-14s %12s %12s %10s %10s %12s %12s\n", "case", "format ns", "libc ns", "format cyc", "libc cyc", "format stack", "libc stack");
+
+    for (size_t index = 0; index < (sizeof(g_benchmark_cases) / sizeof(g_benchmark_cases[0])); index++) {
+        sBenchmarkJob_t format_job = {.benchmark_case = &g_benchmark_cases[index], .formatter = Format_VPrint, .iterations = BENCHMARK_ITERATIONS};
+        sBenchmarkJob_t libc_job = {.benchmark_case = &g_benchmark_cases[index], .formatter = Benchmark_LibcFormat, .iterations = BENCHMARK_ITERATIONS};
+
+        size_t format_stack = Benchmark_MeasureStack(&format_job) - baseline_stack;
+        size_t libc_stack = Benchmark_MeasureStack(&libc_job) - baseline_stack;
+
+        if (0 != strcmp(format_job.buffer, libc_job.buffer)) {
+            printf("mismatch in %s:\n  format: \"%s\"\n  libc:   \"%s\"\n", g_benchmark_cases[index].name, format_job.buffer, libc_job.buffer);
+            is_matching = false;
+        }
+
+        uint64_t format_cycles = 0;
+        uint64_t libc_cycles = 0;
+        double format_ns = Benchmark_MeasureTime(&format_job, &format_cycles);
+        double libc_ns = Benchmark_MeasureTime(&libc_job, &libc_cycles);
+
+        printf("%-14s %12.1f %12.1f %10llu %10llu %12zu %12zu\n", g_benchmark_cases[index].name, format_ns, libc_ns, (unsigned long long) format_cycles, (unsigned long long) libc_cycles, format_stack, libc_stack);
+    }
+
+    return is_matching ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,303 @@
+/*
+ * Host benchmark of the TLSF heap backend (Source/Utility/tlsf.c) against the C library allocator.
+ *
+ * Replays an allocation trace through both and reports the average and worst case cycles per call and the peak
+ * footprint, the distance from the lowest to the highest byte ever handed out, which is what the heap region (or
+ * sbrk for newlib) has to cover. Every call is timed on each of BENCHMARK_REPLAYS replays and the fastest is kept,
+ * so host interrupts and cache misses do not show up as allocator worst cases.
+ *
+ * A trace is a text file with one call per line, "a <id> <size>" allocates and "f <id>" frees. Without a file a
+ * synthetic trace shaped after the framework is used, UART and LED buffers at boot then CLI payloads, WS2812B
+ * animations and UART messages of mixed size and lifetime. The host block header is 16 bytes against 8 on the MCU.
+ *
+ *     gcc -O2 -I Source/Utility Tools/heap_benchmark.c Source/Utility/tlsf.c -o heap_benchmark
+ *     ./heap_benchmark [trace.txt]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tlsf.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define READ_CYCLES() __rdtsc()
+#else
+#define READ_CYCLES() 0ULL
+#endif /* __x86_64__ || __i386__ */
+
+#define BENCHMARK_REPLAYS 20U
+#define BENCHMARK_MAX_IDS 4096U
+#define BENCHMARK_MAX_CALLS 200000U
+#define BENCHMARK_SYNTHETIC_CALLS 50000U
+#define BENCHMARK_TLSF_SIZE (192U * 1024U)
+
+typedef struct sTraceCall {
+    bool is_allocate;
+    uint32_t id;
+    size_t size;
+} sTraceCall_t;
+
+typedef struct sAllocator {
+    const char *name;
+    void (*reset) (void);
+    void *(*allocate) (const size_t size);
+    void (*free) (void *pointer);
+} sAllocator_t;
+
+typedef struct sReplayResult {
+    uint64_t total_cycles;
+    uint64_t worst_allocate;
+    uint64_t worst_free;
+    size_t peak_footprint;
+    size_t peak_live;
+    uint32_t failed;
+} sReplayResult_t;
+
+static sTraceCall_t g_trace[BENCHMARK_MAX_CALLS];
+static size_t g_trace_length = 0;
+static uint64_t g_best_cycles[BENCHMARK_MAX_CALLS];
+
+static uint64_t g_tlsf_memory[BENCHMARK_TLSF_SIZE / sizeof(uint64_t)];
+static Tlsf_Handle g_tlsf = NULL;
+
+static uint32_t g_random_state = 0x2545F491U;
+
+static void Benchmark_TlsfReset (void) {
+    g_tlsf = Tlsf_Init(g_tlsf_memory, sizeof(g_tlsf_memory));
+}
+
+static void *Benchmark_TlsfAllocate (const size_t size) {
+    return Tlsf_Allocate(g_tlsf, size);
+}
+
+static void Benchmark_TlsfFree (void *pointer) {
+    Tlsf_Free(g_tlsf, pointer);
+}
+
+static void Benchmark_LibcReset (void) {
+}
+
+static void *Benchmark_LibcAllocate (const size_t size) {
+    return malloc(size);
+}
+
+static void Benchmark_LibcFree (void *pointer) {
+    free(pointer);
+}
+
+static const sAllocator_t g_allocators[] = {
+    {.name = "tlsf", .reset = Benchmark_TlsfReset, .allocate = Benchmark_TlsfAllocate, .free = Benchmark_TlsfFree},
+    {.name = "libc", .reset = Benchmark_LibcReset, .allocate = Benchmark_LibcAllocate, .free = Benchmark_LibcFree},
+};
+
+static uint32_t Benchmark_Random (const uint32_t range) {
+    g_random_state ^= g_random_state << 13;
+    g_random_state ^= g_random_state >> 17;
+    g_random_state ^= g_random_state << 5;
+
+    return g_random_state % range;
+}
+
+static void Benchmark_AddCall (const bool is_allocate, const uint32_t id, const size_t size) {
+    if (g_trace_length < BENCHMARK_MAX_CALLS) {
+        g_trace[g_trace_length] = (sTraceCall_t) {.is_allocate = is_allocate, .id = id, .size = size};
+        g_trace_length++;
+    }
+}
+
+/* Live ids are kept in a small table, a free picks one of them so lifetimes interleave like in the firmware */
+static void Benchmark_BuildSyntheticTrace (void) {
+    static const size_t boot_sizes[] = {4U * 256U, 4U * 256U, 4U * 128U, 2U, 2U, 60U * 3U, 144U * 3U};
+    static const size_t led_sizes[] = {24U, 20U, 12U, 40U};
+    uint32_t live[256];
+    size_t live_count = 0;
+    uint32_t next_id = 0;
+
+    for (size_t index = 0; index < (sizeof(boot_sizes) / sizeof(boot_sizes[0])); index++) {
+        Benchmark_AddCall(true, next_id, boot_sizes[index]);
+        next_id++;
+    }
+
+    while (g_trace_length < BENCHMARK_SYNTHETIC_CALLS) {
+        uint32_t choice = Benchmark_Random(100U);
+
+        if ((live_count > 0) && ((choice < 45U) || (live_count >= (sizeof(live) / sizeof(live[0]))))) {
+            size_t slot = Benchmark_Random((uint32_t) live_count);
+
+            Benchmark_AddCall(false, live[slot], 0);
+            live_count--;
+            live[slot] = live[live_count];
+
+            continue;
+        }
+
+        size_t size = 0;
+
+        if (choice < 70U) {
+            size = 8U + (Benchmark_Random(3U) * 4U);
+        } else if (choice < 85U) {
+            size = led_sizes[Benchmark_Random(sizeof(led_sizes) / sizeof(led_sizes[0]))];
+        } else {
+            size = 16U + Benchmark_Random(496U);
+        }
+
+        uint32_t id = (next_id % (BENCHMARK_MAX_IDS - 16U)) + 16U;
+
+        Benchmark_AddCall(true, id, size);
+        live[live_count] = id;
+        live_count++;
+        next_id++;
+    }
+
+    while (live_count > 0) {
+        live_count--;
+        Benchmark_AddCall(false, live[live_count], 0);
+    }
+}
+
+static bool Benchmark_LoadTrace (const char *path) {
+    FILE *file = fopen(path, "r");
+
+    if (NULL == file) {
+        return false;
+    }
+
+    char operation = 0;
+    unsigned long id = 0;
+    unsigned long size = 0;
+    char line[64];
+
+    while (NULL != fgets(line, sizeof(line), file)) {
+        if ((3 == sscanf(line, " %c %lu %lu", &operation, &id, &size)) && ('a' == operation) && (id < BENCHMARK_MAX_IDS)) {
+            Benchmark_AddCall(true, (uint32_t) id, (size_t) size);
+        } else if ((2 == sscanf(line, " %c %lu", &operation, &id)) && ('f' == operation) && (id < BENCHMARK_MAX_IDS)) {
+            Benchmark_AddCall(false, (uint32_t) id, 0);
+        }
+    }
+
+    fclose(file);
+
+    return (g_trace_length > 0);
+}
+
+static void Benchmark_Replay (const sAllocator_t *allocator, sReplayResult_t *result) {
+    static void *pointers[BENCHMARK_MAX_IDS];
+    static size_t sizes[BENCHMARK_MAX_IDS];
+    uintptr_t lowest = UINTPTR_MAX;
+    uintptr_t highest = 0;
+    size_t live = 0;
+
+    memset(pointers, 0, sizeof(pointers));
+    allocator->reset();
+
+    for (size_t index = 0; index < g_trace_length; index++) {
+        const sTraceCall_t *call = &g_trace[index];
+        uint64_t start = 0;
+        uint64_t cycles = 0;
+
+        if (call->is_allocate) {
+            if (NULL != pointers[call->id]) {
+                continue;
+            }
+
+            start = READ_CYCLES();
+            pointers[call->id] = allocator->allocate(call->size);
+            cycles = READ_CYCLES() - start;
+
+            if (NULL == pointers[call->id]) {
+                result->failed++;
+
+                continue;
+            }
+
+            sizes[call->id] = call->size;
+            live += call->size;
+
+            uintptr_t address = (uintptr_t) pointers[call->id];
+
+            lowest = (address < lowest) ? address : lowest;
+            highest = ((address + call->size) > highest) ? (address + call->size) : highest;
+            result->peak_live = (live > result->peak_live) ? live : result->peak_live;
+        } else {
+            if (NULL == pointers[call->id]) {
+                continue;
+            }
+
+            start = READ_CYCLES();
+            allocator->free(pointers[call->id]);
+            cycles = READ_CYCLES() - start;
+
+            pointers[call->id] = NULL;
+            live -= sizes[call->id];
+        }
+
+        if (cycles < g_best_cycles[index]) {
+            g_best_cycles[index] = cycles;
+        }
+    }
+
+    for (uint32_t id = 0; id < BENCHMARK_MAX_IDS; id++) {
+        if (NULL != pointers[id]) {
+            allocator->free(pointers[id]);
+        }
+    }
+
+    if (highest > lowest) {
+        result->peak_footprint = highest - lowest;
+    }
+}
+
+static void Benchmark_Run (const sAllocator_t *allocator) {
+    sReplayResult_t result = {0};
+
+    for (size_t index = 0; index < g_trace_length; index++) {
+        g_best_cycles[index] = UINT64_MAX;
+    }
+
+    for (uint32_t replay = 0; replay < BENCHMARK_REPLAYS; replay++) {
+        result = (sReplayResult_t) {0};
+        Benchmark_Replay(allocator, &result);
+    }
+
+    size_t timed_calls = 0;
+
+    for (size_t index = 0; index < g_trace_length; index++) {
+        if (UINT64_MAX == g_best_cycles[index]) {
+            continue;
+        }
+
+        result.total_cycles += g_best_cycles[index];
+        timed_calls++;
+
+        uint64_t *worst = g_trace[index].is_allocate ? &result.worst_allocate : &result.worst_free;
+
+        if (g_best_cycles[index] > *worst) {
+            *worst = g_best_cycles[index];
+        }
+    }
+
+    printf("%-6s %10zu %10.1f %12llu %12llu %14zu %12zu %8u\n", allocator->name, timed_calls, (timed_calls > 0) ? ((double) result.total_cycles / (double) timed_calls) : 0.0, (unsigned long long) result.worst_allocate, (unsigned long long) result.worst_free, result.peak_footprint, result.peak_live, result.failed);
+}
+
+int main (int argc, char **argv) {
+    if (argc > 1) {
+        if (!Benchmark_LoadTrace(argv[1])) {
+            printf("Failed to load trace %s\n", argv[1]);
+
+            return EXIT_FAILURE;
+        }
+    } else {
+        Benchmark_BuildSyntheticTrace();
+    }
+
+    printf("%-6s %10s %10s %12s %12s %14s %12s %8s\n", "heap", "calls", "avg cyc", "worst alloc", "worst free", "peak footprint", "peak live", "failed");
+
+    for (size_t index = 0; index < (sizeof(g_allocators) / sizeof(g_allocators[0])); index++) {
+        Benchmark_Run(&g_allocators[index]);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,454 @@
+/*
+ * Host encoder, decoder and round-trip test of the packet framing used by Source/API/packet_api.c.
+ *
+ * A packet on the wire is COBS(sequence | payload | CRC-16/CCITT-FALSE little endian) followed by a 0x00 delimiter,
+ * built with the same Source/Utility/cobs.c and crc.c as the firmware. Without arguments the round-trip tests run,
+ * otherwise a single packet is encoded or a stream of packets is decoded, both written as hex.
+ *
+ *     gcc -O2 -Wall -Wextra -I Source/Utility Tools/packet_codec.c Source/Utility/cobs.c Source/Utility/crc.c \
+ *         -o packet_codec
+ *     ./packet_codec
+ *     ./packet_codec encode 7 48656c6c6f
+ *     ./packet_codec decode 090748656c6c6f870d00
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cobs.h"
+#include "crc.h"
+
+#define PACKET_MAX_PAYLOAD_SIZE 128U
+#define PACKET_SEQUENCE_SIZE 1U
+#define PACKET_CRC_SIZE 2U
+#define PACKET_OVERHEAD_SIZE (PACKET_SEQUENCE_SIZE + PACKET_CRC_SIZE)
+#define PACKET_RAW_CAPACITY (PACKET_MAX_PAYLOAD_SIZE + PACKET_OVERHEAD_SIZE)
+#define PACKET_ENCODED_CAPACITY (COBS_MAX_ENCODED_SIZE(PACKET_RAW_CAPACITY) + 1U)
+
+#define CODEC_RANDOM_ITERATIONS 100000U
+#define CODEC_STREAM_PACKETS 16U
+#define CODEC_HEX_CAPACITY 4096U
+
+typedef enum eCodecResult {
+    eCodecResult_First = 0,
+    eCodecResult_Ok = eCodecResult_First,
+    eCodecResult_DecodeError,
+    eCodecResult_CrcError,
+    eCodecResult_Last
+} eCodecResult_t;
+
+typedef struct sCodecPacket {
+    uint8_t sequence;
+    size_t size;
+    uint8_t payload[PACKET_MAX_PAYLOAD_SIZE];
+} sCodecPacket_t;
+
+static const char *g_codec_result_names[eCodecResult_Last] = {
+    [eCodecResult_Ok] = "ok",
+    [eCodecResult_DecodeError] = "decode error",
+    [eCodecResult_CrcError] = "crc error",
+};
+
+static uint32_t g_codec_random_state = 0x12345678U;
+
+/* Same layout as Packet_API_Send, the delimiter is appended */
+static bool Codec_Encode (const uint8_t sequence, const uint8_t *payload, const size_t size, uint8_t *encoded, size_t *encoded_size) {
+    uint8_t raw[PACKET_RAW_CAPACITY];
+
+    if (size > PACKET_MAX_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    raw[0] = sequence;
+
+    if (0 != size) {
+        memcpy(&raw[PACKET_SEQUENCE_SIZE], payload, size);
+    }
+
+    size_t crc_offset = PACKET_SEQUENCE_SIZE + size;
+    uint16_t crc = CRC16_Calculate(raw, crc_offset);
+
+    raw[crc_offset] = (uint8_t) (crc & 0xFFU);
+    raw[crc_offset + 1] = (uint8_t) (crc >> 8);
+
+    if (!COBS_Encode(raw, crc_offset + PACKET_CRC_SIZE, encoded, PACKET_ENCODED_CAPACITY - 1, encoded_size)) {
+        return false;
+    }
+
+    encoded[(*encoded_size)++] = 0;
+
+    return true;
+}
+
+/* Same checks as Packet_API_Decode, the frame is given without its delimiter */
+static eCodecResult_t Codec_Decode (const uint8_t *frame, const size_t frame_size, sCodecPacket_t *packet) {
+    uint8_t raw[PACKET_ENCODED_CAPACITY];
+    size_t decoded_size = 0;
+
+    if (!COBS_Decode(frame, frame_size, raw, sizeof(raw), &decoded_size) || (decoded_size < PACKET_OVERHEAD_SIZE)) {
+        return eCodecResult_DecodeError;
+    }
+
+    if ((decoded_size - PACKET_OVERHEAD_SIZE) > PACKET_MAX_PAYLOAD_SIZE) {
+        return eCodecResult_DecodeError;
+    }
+
+    size_t crc_offset = decoded_size - PACKET_CRC_SIZE;
+    uint16_t crc = (uint16_t) (raw[crc_offset] | (raw[crc_offset + 1] << 8));
+
+    if (crc != CRC16_Calculate(raw, crc_offset)) {
+        return eCodecResult_CrcError;
+    }
+
+    packet->sequence = raw[0];
+    packet->size = crc_offset - PACKET_SEQUENCE_SIZE;
+    memcpy(packet->payload, &raw[PACKET_SEQUENCE_SIZE], packet->size);
+
+    return eCodecResult_Ok;
+}
+
+static uint32_t Codec_Random (void) {
+    g_codec_random_state ^= g_codec_random_state << 13;
+    g_codec_random_state ^= g_codec_random_state >> 17;
+    g_codec_random_state ^= g_codec_random_state << 5;
+
+    return g_codec_random_state;
+}
+
+static bool Codec_RoundTrip (const char *name, const uint8_t sequence, const uint8_t *payload, const size_t size) {
+    uint8_t encoded[PACKET_ENCODED_CAPACITY];
+    size_t encoded_size = 0;
+    sCodecPacket_t packet = {0};
+
+    if (!Codec_Encode(sequence, payload, size, encoded, &encoded_size)) {
+        printf("%s: encode of %zu bytes failed\n", name, size);
+
+        return false;
+    }
+
+    if (NULL != memchr(encoded, 0, encoded_size - 1)) {
+        printf("%s: 0x00 inside the encoded frame\n", name);
+
+        return false;
+    }
+
+    eCodecResult_t result = Codec_Decode(encoded, encoded_size - 1, &packet);
+
+    if (eCodecResult_Ok != result) {
+        printf("%s: %s on %zu bytes\n", name, g_codec_result_names[result], size);
+
+        return false;
+    }
+
+    if ((sequence != packet.sequence) || (size != packet.size) || ((0 != size) && (0 != memcmp(payload, packet.payload, size)))) {
+        printf("%s: decoded packet differs\n", name);
+
+        return false;
+    }
+
+    return true;
+}
+
+static bool Codec_TestPatterns (void) {
+    uint8_t payload[PACKET_MAX_PAYLOAD_SIZE];
+    bool is_passed = true;
+
+    is_passed &= Codec_RoundTrip("empty", 0, NULL, 0);
+
+    memset(payload, 0x00, sizeof(payload));
+    is_passed &= Codec_RoundTrip("zeros", 0x00, payload, sizeof(payload));
+
+    memset(payload, 0xFF, sizeof(payload));
+    is_passed &= Codec_RoundTrip("ones", 0xFF, payload, sizeof(payload));
+
+    for (size_t index = 0; index < sizeof(payload); index++) {
+        payload[index] = (uint8_t) (index + 1);
+    }
+
+    is_passed &= Codec_RoundTrip("no zeros", 0x01, payload, sizeof(payload));
+
+    for (size_t size = 0; size <= PACKET_MAX_PAYLOAD_SIZE; size++) {
+        is_passed &= Codec_RoundTrip("every size", (uint8_t) size, payload, size);
+    }
+
+    return is_passed;
+}
+
+/* Runs of 250 to 260 bytes without a zero cross the 254 byte COBS block, larger than a packet so COBS is called directly */
+static bool Codec_TestBlockBoundary (void) {
+    uint8_t raw[300];
+    uint8_t encoded[COBS_MAX_ENCODED_SIZE(sizeof(raw))];
+    uint8_t decoded[sizeof(raw)];
+    bool is_passed = true;
+
+    for (size_t index = 0; index < sizeof(raw); index++) {
+        raw[index] = (uint8_t) ((index % 255U) + 1U);
+    }
+
+    for (size_t size = 250; size <= 260; size++) {
+        size_t encoded_size = 0;
+        size_t decoded_size = 0;
+
+        if (!COBS_Encode(raw, size, encoded, sizeof(encoded), &encoded_size) || (encoded_size > COBS_MAX_ENCODED_SIZE(size))) {
+            printf("block boundary: encode of %zu bytes failed\n", size);
+            is_passed = false;
+
+            continue;
+        }
+
+        if (!COBS_Decode(encoded, encoded_size, decoded, sizeof(decoded), &decoded_size) || (size != decoded_size) || (0 != memcmp(raw, decoded, size))) {
+            printf("block boundary: decode of %zu bytes failed\n", size);
+            is_passed = false;
+        }
+    }
+
+    return is_passed;
+}
+
+static bool Codec_TestRandom (void) {
+    uint8_t payload[PACKET_MAX_PAYLOAD_SIZE];
+
+    for (uint32_t iteration = 0; iteration < CODEC_RANDOM_ITERATIONS; iteration++) {
+        size_t size = Codec_Random() % (PACKET_MAX_PAYLOAD_SIZE + 1U);
+        uint32_t zero_odds = Codec_Random() % 4U;
+
+        for (size_t index = 0; index < size; index++) {
+            uint32_t value = Codec_Random();
+
+            payload[index] = ((value >> 8) % 4U < zero_odds) ? 0 : (uint8_t) value;
+        }
+
+        if (!Codec_RoundTrip("random", (uint8_t) iteration, payload, size)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Every single bit flip must be rejected, by COBS or by the CRC, never decoded into a different packet */
+static bool Codec_TestCorruption (void) {
+    uint8_t payload[32];
+    uint8_t encoded[PACKET_ENCODED_CAPACITY];
+    size_t encoded_size = 0;
+    size_t crc_errors = 0;
+    size_t decode_errors = 0;
+
+    for (size_t index = 0; index < sizeof(payload); index++) {
+        payload[index] = (uint8_t) (index * 7U);
+    }
+
+    Codec_Encode(0x42, payload, sizeof(payload), encoded, &encoded_size);
+
+    for (size_t bit = 0; bit < ((encoded_size - 1) * 8U); bit++) {
+        uint8_t corrupted[PACKET_ENCODED_CAPACITY];
+        sCodecPacket_t packet = {0};
+
+        memcpy(corrupted, encoded, encoded_size);
+        corrupted[bit / 8U] ^= (uint8_t) (1U << (bit % 8U));
+
+        switch (Codec_Decode(corrupted, encoded_size - 1, &packet)) {
+            case eCodecResult_CrcError: {
+                crc_errors++;
+            } break;
+            case eCodecResult_DecodeError: {
+                decode_errors++;
+            } break;
+            default: {
+                printf("corruption: bit %zu flipped and the packet still decoded\n", bit);
+
+                return false;
+            }
+        }
+    }
+
+    for (size_t size = 0; size < (encoded_size - 1); size++) {
+        sCodecPacket_t packet = {0};
+
+        if (eCodecResult_Ok == Codec_Decode(encoded, size, &packet)) {
+            printf("corruption: frame truncated to %zu bytes still decoded\n", size);
+
+            return false;
+        }
+    }
+
+    printf("corruption: %zu bit flips, %zu crc errors, %zu decode errors, truncations rejected\n", crc_errors + decode_errors, crc_errors, decode_errors);
+
+    return true;
+}
+
+/* Several packets back to back, split on the delimiter the way the UART framing does */
+static bool Codec_TestStream (void) {
+    uint8_t stream[CODEC_STREAM_PACKETS * PACKET_ENCODED_CAPACITY];
+    size_t stream_size = 0;
+    sCodecPacket_t sent[CODEC_STREAM_PACKETS] = {0};
+
+    for (size_t index = 0; index < CODEC_STREAM_PACKETS; index++) {
+        size_t encoded_size = 0;
+
+        sent[index].sequence = (uint8_t) (250U + index);
+        sent[index].size = Codec_Random() % (PACKET_MAX_PAYLOAD_SIZE + 1U);
+
+        for (size_t byte = 0; byte < sent[index].size; byte++) {
+            sent[index].payload[byte] = (uint8_t) (Codec_Random() & 0x03U);
+        }
+
+        Codec_Encode(sent[index].sequence, sent[index].payload, sent[index].size, &stream[stream_size], &encoded_size);
+        stream_size += encoded_size;
+    }
+
+    size_t received = 0;
+    size_t start = 0;
+
+    for (size_t position = 0; position < stream_size; position++) {
+        if (0 != stream[position]) {
+            continue;
+        }
+
+        sCodecPacket_t packet = {0};
+
+        if ((received >= CODEC_STREAM_PACKETS) || (eCodecResult_Ok != Codec_Decode(&stream[start], position - start, &packet))) {
+            printf("stream: packet %zu did not decode\n", received);
+
+            return false;
+        }
+
+        if ((sent[received].sequence != packet.sequence) || (sent[received].size != packet.size) || (0 != memcmp(sent[received].payload, packet.payload, packet.size))) {
+            printf("stream: packet %zu differs\n", received);
+
+            return false;
+        }
+
+        received++;
+        start = position + 1;
+    }
+
+    if (CODEC_STREAM_PACKETS != received) {
+        printf("stream: %zu of %u packets received\n", received, CODEC_STREAM_PACKETS);
+
+        return false;
+    }
+
+    return true;
+}
+
+static bool Codec_ParseHex (const char *text, uint8_t *data, const size_t capacity, size_t *size) {
+    size_t length = strlen(text);
+
+    if ((0 != (length % 2U)) || ((length / 2U) > capacity)) {
+        return false;
+    }
+
+    for (size_t index = 0; index < (length / 2U); index++) {
+        unsigned int value = 0;
+
+        if (1 != sscanf(&text[index * 2U], "%2x", &value)) {
+            return false;
+        }
+
+        data[index] = (uint8_t) value;
+    }
+
+    *size = length / 2U;
+
+    return true;
+}
+
+static void Codec_PrintHex (const uint8_t *data, const size_t size) {
+    for (size_t index = 0; index < size; index++) {
+        printf("%02x", data[index]);
+    }
+
+    printf("\n");
+
+    return;
+}
+
+static int Codec_EncodeCommand (const char *sequence_text, const char *payload_text) {
+    uint8_t payload[PACKET_MAX_PAYLOAD_SIZE];
+    uint8_t encoded[PACKET_ENCODED_CAPACITY];
+    size_t size = 0;
+    size_t encoded_size = 0;
+
+    if (!Codec_ParseHex(payload_text, payload, sizeof(payload), &size)) {
+        printf("payload must be hex of at most %u bytes\n", PACKET_MAX_PAYLOAD_SIZE);
+
+        return EXIT_FAILURE;
+    }
+
+    if (!Codec_Encode((uint8_t) strtoul(sequence_text, NULL, 0), payload, size, encoded, &encoded_size)) {
+        return EXIT_FAILURE;
+    }
+
+    Codec_PrintHex(encoded, encoded_size);
+
+    return EXIT_SUCCESS;
+}
+
+static int Codec_DecodeCommand (const char *stream_text) {
+    static uint8_t stream[CODEC_HEX_CAPACITY];
+    size_t stream_size = 0;
+    size_t start = 0;
+    int exit_code = EXIT_SUCCESS;
+
+    if (!Codec_ParseHex(stream_text, stream, sizeof(stream), &stream_size)) {
+        printf("stream must be hex of at most %u bytes\n", CODEC_HEX_CAPACITY);
+
+        return EXIT_FAILURE;
+    }
+
+    for (size_t position = 0; position < stream_size; position++) {
+        if (0 != stream[position]) {
+            continue;
+        }
+
+        sCodecPacket_t packet = {0};
+        eCodecResult_t result = Codec_Decode(&stream[start], position - start, &packet);
+
+        if (eCodecResult_Ok == result) {
+            printf("seq %3u, %3zu bytes: ", packet.sequence, packet.size);
+            Codec_PrintHex(packet.payload, packet.size);
+        } else {
+            printf("frame at %zu: %s\n", start, g_codec_result_names[result]);
+            exit_code = EXIT_FAILURE;
+        }
+
+        start = position + 1;
+    }
+
+    if (start != stream_size) {
+        printf("%zu trailing bytes without a delimiter\n", stream_size - start);
+    }
+
+    return exit_code;
+}
+
+int main (int argc, char *argv[]) {
+    if ((4 == argc) && (0 == strcmp(argv[1], "encode"))) {
+        return Codec_EncodeCommand(argv[2], argv[3]);
+    }
+
+    if ((3 == argc) && (0 == strcmp(argv[1], "decode"))) {
+        return Codec_DecodeCommand(argv[2]);
+    }
+
+    if (1 != argc) {
+        printf("usage: %s [encode <sequence> <hex payload> | decode <hex stream>]\n", argv[0]);
+
+        return EXIT_FAILURE;
+    }
+
+    bool is_passed = true;
+
+    is_passed &= Codec_TestPatterns();
+    is_passed &= Codec_TestBlockBoundary();
+    is_passed &= Codec_TestRandom();
+    is_passed &= Codec_TestCorruption();
+    is_passed &= Codec_TestStream();
+
+    printf("%s\n", is_passed ? "all round trips passed" : "round trip FAILED");
+
+    return is_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,305 @@
+/*
+ * Host producer/consumer stress test and throughput benchmark of the SPSC ring buffer (Source/Utility/ring_buffer.c).
+ *
+ * Every case runs a producer and a consumer thread over one ring, the way the UART interrupt and the FSM thread share
+ * the RX ring. The producer writes a byte pattern derived from the free-running stream position, the consumer checks
+ * every byte it takes out against it, so a lost, doubled or torn byte fails the run. The overwrite case drives an
+ * OverwriteOldest ring faster than it is read, as circular DMA does, and the consumer reads zero-copy through
+ * PeekTail and ConsumeFrom: spans the producer overwrote during the copy must be refused, never delivered.
+ *
+ * Reported are the bytes moved per second and, for the overwrite case, how many consumes were refused. Build once
+ * with -fsanitize=thread to check the memory ordering, the numbers are only meaningful from the -O2 build. The
+ * overwrite case races on the storage on purpose, as DMA does, so ThreadSanitizer reports it.
+ *
+ *     gcc -O2 -pthread -I Source/Utility Tools/ring_buffer_benchmark.c Source/Utility/ring_buffer.c \
+ *         -o ring_buffer_benchmark
+ *     ./ring_buffer_benchmark
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ring_buffer.h"
+
+#define BENCHMARK_CAPACITY 1024U
+#define BENCHMARK_STREAM_SIZE (64U * 1024U * 1024U)
+#define BENCHMARK_BYTE_STREAM_SIZE (8U * 1024U * 1024U)
+#define BENCHMARK_MAX_CHUNK 256U
+
+/* 251 is prime, so the pattern does not repeat with any power of two ring capacity */
+#define BENCHMARK_PATTERN(position) ((uint8_t) ((position) % 251U))
+
+typedef enum eBenchmarkMode {
+    eBenchmarkMode_First = 0,
+    eBenchmarkMode_Byte = eBenchmarkMode_First,
+    eBenchmarkMode_Bulk,
+    eBenchmarkMode_ZeroCopy,
+    eBenchmarkMode_Overwrite,
+    eBenchmarkMode_Last
+} eBenchmarkMode_t;
+
+typedef struct sBenchmarkCase {
+    const char *name;
+    eBenchmarkMode_t mode;
+    eRingBufferPolicy_t policy;
+    size_t chunk_size;
+    size_t stream_size;
+} sBenchmarkCase_t;
+
+typedef struct sBenchmarkRun {
+    const sBenchmarkCase_t *benchmark_case;
+    RingBuffer_Handle ring_buffer;
+    atomic_bool is_producer_done;
+    size_t consumed;
+    size_t refused;
+    size_t errors;
+} sBenchmarkRun_t;
+
+static const sBenchmarkCase_t g_benchmark_cases[] = {
+    {.name = "push/pop byte", .mode = eBenchmarkMode_Byte, .policy = eRingBufferPolicy_Reject, .chunk_size = 1, .stream_size = BENCHMARK_BYTE_STREAM_SIZE},
+    {.name = "bulk 8", .mode = eBenchmarkMode_Bulk, .policy = eRingBufferPolicy_Reject, .chunk_size = 8, .stream_size = BENCHMARK_STREAM_SIZE},
+    {.name = "bulk 64", .mode = eBenchmarkMode_Bulk, .policy = eRingBufferPolicy_Reject, .chunk_size = 64, .stream_size = BENCHMARK_STREAM_SIZE},
+    {.name = "bulk random", .mode = eBenchmarkMode_Bulk, .policy = eRingBufferPolicy_Reject, .chunk_size = 0, .stream_size = BENCHMARK_STREAM_SIZE},
+    {.name = "reserve/peek", .mode = eBenchmarkMode_ZeroCopy, .policy = eRingBufferPolicy_DropNewest, .chunk_size = BENCHMARK_MAX_CHUNK, .stream_size = BENCHMARK_STREAM_SIZE},
+    {.name = "overwrite", .mode = eBenchmarkMode_Overwrite, .policy = eRingBufferPolicy_OverwriteOldest, .chunk_size = 0, .stream_size = BENCHMARK_STREAM_SIZE},
+};
+
+/* Chunk size 0 picks a random size per call, both threads keep their own generator state */
+static size_t Benchmark_GetChunkSize (const sBenchmarkCase_t *benchmark_case, uint32_t *random_state) {
+    if (0 != benchmark_case->chunk_size) {
+        return benchmark_case->chunk_size;
+    }
+
+    *random_state ^= *random_state << 13;
+    *random_state ^= *random_state >> 17;
+    *random_state ^= *random_state << 5;
+
+    return (*random_state % BENCHMARK_MAX_CHUNK) + 1U;
+}
+
+static void Benchmark_FillPattern (uint8_t *data, const size_t position, const size_t size) {
+    for (size_t index = 0; index < size; index++) {
+        data[index] = BENCHMARK_PATTERN(position + index);
+    }
+
+    return;
+}
+
+static size_t Benchmark_CountErrors (const uint8_t *data, const size_t position, const size_t size) {
+    size_t errors = 0;
+
+    for (size_t index = 0; index < size; index++) {
+        if (BENCHMARK_PATTERN(position + index) != data[index]) {
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+static void *Benchmark_Producer (void *arg) {
+    sBenchmarkRun_t *run = (sBenchmarkRun_t*) arg;
+    const sBenchmarkCase_t *benchmark_case = run->benchmark_case;
+    uint8_t chunk[BENCHMARK_MAX_CHUNK];
+    uint32_t random_state = 0x9E3779B9U;
+    size_t position = 0;
+
+    while (position < benchmark_case->stream_size) {
+        size_t size = Benchmark_GetChunkSize(benchmark_case, &random_state);
+
+        if (size > (benchmark_case->stream_size - position)) {
+            size = benchmark_case->stream_size - position;
+        }
+
+        switch (benchmark_case->mode) {
+            case eBenchmarkMode_Byte: {
+                if (Ring_Buffer_Push(run->ring_buffer, BENCHMARK_PATTERN(position))) {
+                    position++;
+                } else {
+                    sched_yield();
+                }
+            } break;
+            case eBenchmarkMode_ZeroCopy: {
+                sRingBufferSpan_t first = {0};
+                sRingBufferSpan_t second = {0};
+
+                if (!Ring_Buffer_Reserve(run->ring_buffer, &first, &second) || (0 == first.size)) {
+                    sched_yield();
+
+                    break;
+                }
+
+                size = (size < first.size) ? size : first.size;
+                Benchmark_FillPattern(first.data, position, size);
+                Ring_Buffer_Commit(run->ring_buffer, size);
+                position += size;
+            } break;
+            case eBenchmarkMode_Overwrite: {
+                /* Never waits for the consumer, the stream position is the ring head as long as chunks fit the ring */
+                Benchmark_FillPattern(chunk, position, size);
+                position += Ring_Buffer_PushBulk(run->ring_buffer, chunk, size);
+
+                /* Gives the consumer a turn after every chunk, on a single core it would otherwise only see the end */
+                sched_yield();
+            } break;
+            default: {
+                Benchmark_FillPattern(chunk, position, size);
+
+                size_t count = Ring_Buffer_PushBulk(run->ring_buffer, chunk, size);
+
+                position += count;
+
+                if (0 == count) {
+                    sched_yield();
+                }
+            } break;
+        }
+    }
+
+    atomic_store_explicit(&run->is_producer_done, true, memory_order_release);
+
+    return NULL;
+}
+
+static void *Benchmark_Consumer (void *arg) {
+    sBenchmarkRun_t *run = (sBenchmarkRun_t*) arg;
+    const sBenchmarkCase_t *benchmark_case = run->benchmark_case;
+    uint8_t chunk[BENCHMARK_CAPACITY];
+    uint32_t random_state = 0x2545F491U;
+
+    while (true) {
+        bool is_producer_done = atomic_load_explicit(&run->is_producer_done, memory_order_acquire);
+        size_t size = Benchmark_GetChunkSize(benchmark_case, &random_state);
+        size_t count = 0;
+
+        switch (benchmark_case->mode) {
+            case eBenchmarkMode_Byte: {
+                if (Ring_Buffer_Pop(run->ring_buffer, chunk)) {
+                    run->errors += Benchmark_CountErrors(chunk, run->consumed, 1);
+                    count = 1;
+                }
+            } break;
+            case eBenchmarkMode_ZeroCopy: {
+                sRingBufferSpan_t first = {0};
+                sRingBufferSpan_t second = {0};
+
+                if (Ring_Buffer_Peek(run->ring_buffer, &first, &second)) {
+                    count = (size < first.size) ? size : first.size;
+                    run->errors += Benchmark_CountErrors(first.data, run->consumed, count);
+                    Ring_Buffer_Consume(run->ring_buffer, count);
+                }
+            } break;
+            case eBenchmarkMode_Overwrite: {
+                sRingBufferSpan_t first = {0};
+                sRingBufferSpan_t second = {0};
+                size_t tail = 0;
+
+                if (!Ring_Buffer_PeekTail(run->ring_buffer, &tail, &first, &second)) {
+                    break;
+                }
+
+                /* Reads a quarter of what the producer writes per turn, so it falls behind and gets overwritten */
+                size_t wanted = (size / 4U) + 1U;
+
+                /* Every other read lets the producer run between peek and copy, ConsumeFrom must refuse what it hit */
+                if (0 != (random_state & 1U)) {
+                    sched_yield();
+                }
+
+                /* Copy first, the way UART_API copies a frame out, and check only what ConsumeFrom accepted */
+                count = (wanted < first.size) ? wanted : first.size;
+                memcpy(chunk, first.data, count);
+
+                if (!Ring_Buffer_ConsumeFrom(run->ring_buffer, tail, count)) {
+                    run->refused++;
+                    count = 0;
+
+                    break;
+                }
+
+                run->errors += Benchmark_CountErrors(chunk, tail, count);
+
+                /* Takes turns with the producer like it does, otherwise one thread runs a whole time slice alone */
+                sched_yield();
+            } break;
+            default: {
+                count = Ring_Buffer_PopBulk(run->ring_buffer, chunk, size);
+                run->errors += Benchmark_CountErrors(chunk, run->consumed, count);
+            } break;
+        }
+
+        run->consumed += count;
+
+        if (0 != count) {
+            continue;
+        }
+
+        /* The producer finished before this empty read, so nothing more can arrive */
+        if (is_producer_done && Ring_Buffer_IsEmpty(run->ring_buffer)) {
+            break;
+        }
+
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+static bool Benchmark_Run (const sBenchmarkCase_t *benchmark_case) {
+    sBenchmarkRun_t run = {.benchmark_case = benchmark_case};
+    pthread_t producer;
+    pthread_t consumer;
+    struct timespec start;
+    struct timespec end;
+
+    run.ring_buffer = Ring_Buffer_Init(BENCHMARK_CAPACITY, benchmark_case->policy);
+
+    if (NULL == run.ring_buffer) {
+        printf("%-14s ring buffer init failed\n", benchmark_case->name);
+
+        return false;
+    }
+
+    atomic_init(&run.is_producer_done, false);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    pthread_create(&consumer, NULL, Benchmark_Consumer, &run);
+    pthread_create(&producer, NULL, Benchmark_Producer, &run);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double elapsed_s = (double) (end.tv_sec - start.tv_sec) + ((double) (end.tv_nsec - start.tv_nsec) / 1e9);
+    sRingBufferStats_t stats = {0};
+
+    Ring_Buffer_GetStats(run.ring_buffer, &stats);
+    Ring_Buffer_DeInit(run.ring_buffer);
+
+    printf("%-14s %10.1f %12zu %10zu %10zu %8zu\n", benchmark_case->name, (double) run.consumed / elapsed_s / 1e6, run.consumed, stats.dropped, run.refused, run.errors);
+
+    /* Only the overwrite case may lose bytes, and then exactly the ones the ring reports as dropped */
+    bool is_complete = (benchmark_case->stream_size == (run.consumed + stats.dropped));
+
+    return (0 == run.errors) && is_complete;
+}
+
+int main (void) {
+    bool is_passed = true;
+
+    printf("%-14s %10s %12s %10s %10s %8s\n", "case", "MB/s", "consumed", "dropped", "refused", "errors");
+
+    for (size_t index = 0; index < (sizeof(g_benchmark_cases) / sizeof(g_benchmark_cases[0])); index++) {
+        is_passed &= Benchmark_Run(&g_benchmark_cases[index]);
+    }
+
+    printf("%s\n", is_passed ? "stress test passed" : "stress test FAILED");
+
+    return is_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,288 @@
+#!/usr/bin/env python3
+"""
+Host decoder for tokenized Debug_API traces (DEBUG_TOKENIZED).
+
+The firmware sends each trace as 0x00 | COBS(payload) | 0x00, where the payload is
+
+    level (u8, bit 7 set when arguments were truncated, bit 6 when a timestamp follows)
+    format token (u16), module token (u16)
+    cycle count (u32)                                  -- DEBUG_TIMESTAMP only
+    file token (u16), line (u16)                       -- error level only
+    arguments in format order                         -- 4 bytes, 8 for %ll/%j and floating point,
+                                                         u8 length + bytes for %s
+
+Tokens are byte offsets into the trace_fmt section of the firmware ELF, 0xFFFF means none.
+Anything between frames is printed as plain text, so CLI responses on the same UART stay readable.
+
+    trace_decoder.py firmware.elf --export strings.json         extract the string table at build time
+    trace_decoder.py firmware.elf capture.bin                   decode a raw capture
+    trace_decoder.py strings.json /dev/ttyACM0 --baud 115200    decode live (requires pyserial)
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+TOKEN_SECTION = "trace_fmt"
+TOKEN_NONE = 0xFFFF
+TOKEN_SECTION_MAX_SIZE = 0xFFFE
+TRUNCATED_FLAG = 0x80
+TIMESTAMP_FLAG = 0x40
+LEVEL_NAMES = ("INF", "WRN", "ERR")
+LEVEL_ERROR = 2
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|L|z|j|t)?([diuxXocspfFeEgG%])")
+
+
+def read_section(elf_path, section_name):
+    with open(elf_path, "rb") as elf_file:
+        elf = elf_file.read()
+
+    if elf[:4] != b"\x7fELF":
+        raise ValueError(f"{elf_path} is not an ELF file")
+
+    is_64_bit = (elf[4] == 2)
+    endian = "<" if (elf[5] == 1) else ">"
+
+    if is_64_bit:
+        section_offset, = struct.unpack_from(endian + "Q", elf, 0x28)
+        entry_size, entry_count, names_index = struct.unpack_from(endian + "HHH", elf, 0x3A)
+        header_format = endian + "IIQQQQ"
+    else:
+        section_offset, = struct.unpack_from(endian + "I", elf, 0x20)
+        entry_size, entry_count, names_index = struct.unpack_from(endian + "HHH", elf, 0x2E)
+        header_format = endian + "IIIIII"
+
+    headers = [struct.unpack_from(header_format, elf, section_offset + (index * entry_size)) for index in range(entry_count)]
+    names_offset = headers[names_index][4]
+
+    for name_offset, _, _, _, offset, size in headers:
+        name_end = elf.index(b"\0", names_offset + name_offset)
+
+        if elf[names_offset + name_offset:name_end].decode() == section_name:
+            return elf[offset:offset + size]
+
+    raise ValueError(f"{elf_path} has no {section_name} section, is DEBUG_TOKENIZED enabled?")
+
+
+def build_string_table(section):
+    strings = {}
+    start = 0
+
+    while start < len(section):
+        end = section.find(b"\0", start)
+
+        if end < 0:
+            end = len(section)
+
+        if end > start:
+            strings[start] = section[start:end].decode("utf-8", "replace")
+
+        start = end + 1
+
+    return strings
+
+
+def load_string_table(path):
+    if path.endswith(".json"):
+        with open(path) as table_file:
+            return {int(token): string for token, string in json.load(table_file).items()}
+
+    section = read_section(path, TOKEN_SECTION)
+
+    if len(section) > TOKEN_SECTION_MAX_SIZE:
+        raise ValueError(f"{TOKEN_SECTION} is {len(section)} bytes, 16 bit tokens reach {TOKEN_SECTION_MAX_SIZE}")
+
+    return build_string_table(section)
+
+
+def cobs_decode(data):
+    decoded = bytearray()
+    index = 0
+
+    while index < len(data):
+        code = data[index]
+
+        if (code == 0) or ((index + code) > len(data)):
+            raise ValueError("bad COBS block")
+
+        decoded += data[index + 1:index + code]
+        index += code
+
+        if (code < 0xFF) and (index < len(data)):
+            decoded.append(0)
+
+    return bytes(decoded)
+
+
+class Reader:
+    def __init__(self, payload):
+        self.payload = payload
+        self.position = 0
+
+    def take(self, size):
+        if (self.position + size) > len(self.payload):
+            raise EOFError
+        chunk = self.payload[self.position:self.position + size]
+        self.position += size
+        return chunk
+
+    def unpack(self, layout):
+        return struct.unpack("<" + layout, self.take(struct.calcsize("<" + layout)))[0]
+
+
+def render(format_string, reader):
+    def substitute(match):
+        flags, width, precision, modifier, conversion = match.groups()
+
+        if conversion == "%":
+            return "%"
+
+        if width == "*":
+            width = str(reader.unpack("i"))
+
+        if precision == "*":
+            precision = str(reader.unpack("i"))
+
+        spec = "%" + flags + (width or "") + (("." + precision) if precision is not None else "")
+
+        if conversion in "fFeEgG":
+            return (spec + conversion) % reader.unpack("d")
+
+        if conversion == "s":
+            length = reader.unpack("B")
+            return (spec + "s") % reader.take(length).decode("utf-8", "replace")
+
+        if conversion == "p":
+            return "0x%08x" % reader.unpack("I")
+
+        is_wide = modifier in ("ll", "j")
+        is_signed = conversion in "di"
+        value = reader.unpack(("q" if is_signed else "Q") if is_wide else ("i" if is_signed else "I"))
+
+        if conversion == "c":
+            return (spec + "c") % chr(value & 0xFF)
+
+        return (spec + ("d" if conversion in "diu" else conversion)) % value
+
+    pieces = []
+    last_end = 0
+
+    for match in CONVERSION.finditer(format_string):
+        pieces.append(format_string[last_end:match.start()])
+
+        try:
+            pieces.append(substitute(match))
+        except EOFError:
+            pieces.append("<?>")
+            last_end = len(format_string)
+            break
+
+        last_end = match.end()
+
+    pieces.append(format_string[last_end:])
+
+    return "".join(pieces)
+
+
+def decode_frame(payload, strings):
+    reader = Reader(payload)
+
+    level = reader.unpack("B")
+    format_string = strings[reader.unpack("H")]
+    module_token = reader.unpack("H")
+    module = strings.get(module_token, "?") if module_token != TOKEN_NONE else "?"
+
+    is_truncated = bool(level & TRUNCATED_FLAG)
+    has_timestamp = bool(level & TIMESTAMP_FLAG)
+    level &= ~(TRUNCATED_FLAG | TIMESTAMP_FLAG)
+
+    if level >= len(LEVEL_NAMES):
+        raise ValueError("bad level")
+
+    prefix = f"@{reader.unpack('I')} " if has_timestamp else ""
+    prefix += f"[{module}.{LEVEL_NAMES[level]}] "
+
+    if level == LEVEL_ERROR:
+        file_name = strings.get(reader.unpack("H"), "?")
+        prefix += f"(file: {file_name}, line: {reader.unpack('H')}) "
+
+    text = render(format_string, reader)
+
+    if is_truncated:
+        text = text.rstrip("\n") + " <truncated>\n"
+    elif reader.position != len(payload):
+        raise ValueError("trailing bytes")
+
+    return prefix + text
+
+
+def decode_stream(chunks, strings, output):
+    pending = bytearray()
+
+    for chunk in chunks:
+        pending += chunk
+
+        while True:
+            end = pending.find(b"\0")
+
+            if end < 0:
+                break
+
+            block = bytes(pending[:end])
+            del pending[:end + 1]
+
+            if not block:
+                continue
+
+            try:
+                output.write(decode_frame(cobs_decode(block), strings))
+            except (ValueError, KeyError, EOFError, struct.error):
+                output.write(block.decode("utf-8", "replace"))
+
+            output.flush()
+
+    if pending:
+        output.write(pending.decode("utf-8", "replace"))
+
+
+def read_chunks(source, baudrate):
+    if source == "-":
+        while chunk := sys.stdin.buffer.read1(4096):
+            yield chunk
+        return
+
+    if source.startswith(("/dev/", "COM")):
+        import serial
+
+        with serial.Serial(source, baudrate, timeout=0.1) as port:
+            while True:
+                yield port.read(4096)
+
+    with open(source, "rb") as capture_file:
+        while chunk := capture_file.read(4096):
+            yield chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode tokenized Debug_API traces")
+    parser.add_argument("strings", help="firmware ELF or a table exported with --export")
+    parser.add_argument("source", nargs="?", default="-", help="capture file, serial port or - for stdin")
+    parser.add_argument("--baud", type=int, default=115200, help="serial port baud rate")
+    parser.add_argument("--export", metavar="JSON", help="write the string table and exit")
+    arguments = parser.parse_args()
+
+    strings = load_string_table(arguments.strings)
+
+    if arguments.export:
+        with open(arguments.export, "w") as table_file:
+            json.dump({str(token): string for token, string in sorted(strings.items())}, table_file, indent=1)
+        return
+
+    decode_stream(read_chunks(arguments.source, arguments.baud), strings, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+Converts a captured Debug_API log with DEBUG_TIMESTAMP enabled into Chrome trace-event JSON, open it in
+chrome://tracing or https://ui.perfetto.dev.
+
+Trace lines look like "@<cycles> [MODULE.INF] message". Every module gets its own track, TRACE_SCOPE_BEGIN/END
+markers (">> name" / "<< name") become duration slices and any other line an instant event. The 32 bit cycle
+counter is unwrapped assuming consecutive lines are less than half a wrap (~21.5 s at 100 MHz) apart, a smaller step
+back is a line traced out of order (an interrupt between another line's timestamp and its ring slot), not a wrap.
+
+    trace_to_chrome.py capture.log -o trace.json --clock-hz 100000000
+    trace_decoder.py firmware.elf capture.bin | trace_to_chrome.py - -o trace.json     tokenized captures
+"""
+
+import argparse
+import json
+import re
+import sys
+
+COUNTER_WRAP = 1 << 32
+COUNTER_HALF_WRAP = COUNTER_WRAP // 2
+SCOPE_BEGIN = ">> "
+SCOPE_END = "<< "
+PROCESS_ID = 1
+
+TRACE_LINE = re.compile(r"@(\d+) \[([^.\]]+)\.(INF|WRN|ERR)\] (?:\(file: ([^,]*), line: (\d+)\) )?(.*)")
+
+
+def convert(lines, clock_hz):
+    events = []
+    tracks = {}
+    previous_cycles = None
+    unwrapped_cycles = 0
+
+    for line in lines:
+        match = TRACE_LINE.search(line)
+
+        if not match:
+            continue
+
+        cycles, module, level, file_name, line_number, message = match.groups()
+        cycles = int(cycles)
+
+        if previous_cycles is None:
+            unwrapped_cycles = cycles
+        else:
+            step = (cycles - previous_cycles) % COUNTER_WRAP
+
+            if step >= COUNTER_HALF_WRAP:
+                step -= COUNTER_WRAP
+
+            unwrapped_cycles += step
+
+        previous_cycles = cycles
+
+        if module not in tracks:
+            tracks[module] = len(tracks) + 1
+            events.append({"name": "thread_name", "ph": "M", "pid": PROCESS_ID, "tid": tracks[module], "args": {"name": module}})
+
+        event = {"pid": PROCESS_ID, "tid": tracks[module], "ts": (unwrapped_cycles * 1e6) / clock_hz}
+        message = message.rstrip()
+
+        if message.startswith(SCOPE_BEGIN):
+            event.update(name=message[len(SCOPE_BEGIN):], ph="B")
+        elif message.startswith(SCOPE_END):
+            event.update(name=message[len(SCOPE_END):], ph="E")
+        else:
+            event.update(name=message, ph="i", s="t", args={"level": level})
+
+            if file_name is not None:
+                event["args"].update(file=file_name, line=int(line_number))
+
+        events.append(event)
+
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert timestamped Debug_API logs to Chrome trace-event JSON")
+    parser.add_argument("source", nargs="?", default="-", help="captured text log or - for stdin")
+    parser.add_argument("-o", "--output", default="-", help="JSON output file, - for stdout")
+    parser.add_argument("--clock-hz", type=float, default=100e6, help="core clock the cycle counter runs at (SYSTEM_CLOCK_HZ)")
+    arguments = parser.parse_args()
+
+    if arguments.source == "-":
+        trace = convert(sys.stdin, arguments.clock_hz)
+    else:
+        with open(arguments.source, encoding="utf-8", errors="replace") as log_file:
+            trace = convert(log_file, arguments.clock_hz)
+
+    if arguments.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(arguments.output, "w") as trace_file:
+            json.dump(trace, trace_file)
+
+
+if __name__ == "__main__":
+    main()